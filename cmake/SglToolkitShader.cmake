@@ -0,0 +1,75 @@
+#Pack shaders into a bundle at build time, the bundle is rebuilt whenever a shader or any file it includes is changed.
+#sgt_add_shader_bundle(<target> OUTPUT <bundle> [ROOT <dir>] [INCLUDE_DIRS <dir>...] SHADERS <shader>...)
+#Shaders are named by their path relative to ROOT, which defaults to the current source directory.
+function(sgt_add_shader_bundle TARGET_NAME)
+	cmake_parse_arguments(BUNDLE "" "OUTPUT;ROOT" "INCLUDE_DIRS;SHADERS" ${ARGN})
+	if(NOT BUNDLE_OUTPUT OR NOT BUNDLE_SHADERS)
+		message(FATAL_ERROR "sgt_add_shader_bundle: OUTPUT and SHADERS are required")
+	endif()
+	if(NOT BUNDLE_ROOT)
+		set(BUNDLE_ROOT ${CMAKE_CURRENT_SOURCE_DIR})
+	endif()
+
+	set(BUNDLE_ARGS -o ${BUNDLE_OUTPUT} -r ${BUNDLE_ROOT})
+	foreach(DIR ${BUNDLE_INCLUDE_DIRS})
+		list(APPEND BUNDLE_ARGS -I ${DIR})
+	endforeach()
+	set(BUNDLE_SHADER_PATH "")
+	foreach(SHADER ${BUNDLE_SHADERS})
+		get_filename_component(SHADER_PATH ${SHADER} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+		list(APPEND BUNDLE_SHADER_PATH ${SHADER_PATH})
+	endforeach()
+
+	#included files are reported by the tool through a depfile, where the generator supports it
+	set(BUNDLE_DEPFILE "")
+	if(CMAKE_GENERATOR MATCHES "Ninja" OR CMAKE_VERSION VERSION_GREATER_EQUAL 3.20)
+		set(BUNDLE_DEPFILE DEPFILE ${BUNDLE_OUTPUT}.d)
+		list(APPEND BUNDLE_ARGS -d ${BUNDLE_OUTPUT}.d)
+	endif()
+
+	add_custom_command(OUTPUT ${BUNDLE_OUTPUT}
+		COMMAND SgTShaderPack ${BUNDLE_ARGS} ${BUNDLE_SHADER_PATH}
+		DEPENDS SgTShaderPack ${BUNDLE_SHADER_PATH}
+		${BUNDLE_DEPFILE}
+		COMMENT "Packing shader bundle ${BUNDLE_OUTPUT}"
+		VERBATIM)
+	add_custom_target(${TARGET_NAME} ALL DEPENDS ${BUNDLE_OUTPUT})
+endfunction()
+
+#Compile GLSL shaders into SPIR-V modules for OpenGL at build time, to be loaded by SgTShaderProc::addShaderBinary.
+#sgt_add_spirv(<target> OUTPUT_DIR <dir> [INCLUDE_DIRS <dir>...] [DEFINES <macro>...] SHADERS <shader>...)
+#The stage is deduced from the file extension (.vert, .tesc, .tese, .geom, .frag, .comp), and each module is named <shader>.spv.
+function(sgt_add_spirv TARGET_NAME)
+	cmake_parse_arguments(SPIRV "" "OUTPUT_DIR" "INCLUDE_DIRS;DEFINES;SHADERS" ${ARGN})
+	if(NOT SPIRV_OUTPUT_DIR OR NOT SPIRV_SHADERS)
+		message(FATAL_ERROR "sgt_add_spirv: OUTPUT_DIR and SHADERS are required")
+	endif()
+	find_program(GLSLANG_VALIDATOR glslangValidator HINTS $ENV{VULKAN_SDK}/bin)
+	if(NOT GLSLANG_VALIDATOR)
+		message(FATAL_ERROR "sgt_add_spirv: glslangValidator is not found")
+	endif()
+
+	#-G targets OpenGL rather than Vulkan
+	set(SPIRV_ARGS -G)
+	foreach(DIR ${SPIRV_INCLUDE_DIRS})
+		list(APPEND SPIRV_ARGS -I${DIR})
+	endforeach()
+	foreach(DEFINE ${SPIRV_DEFINES})
+		list(APPEND SPIRV_ARGS -D${DEFINE})
+	endforeach()
+
+	set(SPIRV_MODULE "")
+	foreach(SHADER ${SPIRV_SHADERS})
+		get_filename_component(SHADER_PATH ${SHADER} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+		get_filename_component(SHADER_NAME ${SHADER} NAME)
+		set(MODULE ${SPIRV_OUTPUT_DIR}/${SHADER_NAME}.spv)
+		add_custom_command(OUTPUT ${MODULE}
+			COMMAND ${CMAKE_COMMAND} -E make_directory ${SPIRV_OUTPUT_DIR}
+			COMMAND ${GLSLANG_VALIDATOR} ${SPIRV_ARGS} -o ${MODULE} ${SHADER_PATH}
+			DEPENDS ${SHADER_PATH}
+			COMMENT "Compiling ${SHADER_NAME} to SPIR-V"
+			VERBATIM)
+		list(APPEND SPIRV_MODULE ${MODULE})
+	endforeach()
+	add_custom_target(${TARGET_NAME} ALL DEPENDS ${SPIRV_MODULE})
+endfunction()
\ No newline at end of file
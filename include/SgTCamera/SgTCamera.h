@@ -3,6 +3,7 @@
 #define _SgTCamera_H_
 
 #include "../SgTDefineFile.h"
+#include "../SgTTripleBuffer.h"
 
 /**
  * @brief Simple OpenGL Toolkit
@@ -12,6 +13,7 @@ namespace SglToolkit {
 	/**
 	 * @brief Base camera with full abstraction, a general camera class contains the basic properties of a camera such as Position, Front and Up.
 	 * Using this camera class to develop other types of camera, with independent implementations.
+	 * A camera is not copyable, because it owns the snapshot buffer shared with a reader thread.
 	*/
 	class SgTCamera {
 	public:
@@ -36,6 +38,22 @@ namespace SglToolkit {
 
 		};
 
+		/**
+		 * @brief An immutable copy of the camera published for another thread, e.g. the render thread drawing the last frame
+		 * while the update thread works on the next one
+		*/
+		struct SgTCameraState {
+		public:
+
+			SgTvec3 position, front, up, right;
+			float yaw, pitch, zoom;
+			float aspect, nearPlane, farPlane;
+			SgTmat4 view, projection, viewProjection, inverseView;
+			//The version of the camera the state was taken at, 0 if nothing has been published
+			unsigned long long version;
+
+		};
+
 	protected:
 
 		//Default camera attributes
@@ -49,10 +67,40 @@ namespace SglToolkit {
 		static constexpr SgTvec3 POSITION = SgTvec3(0.0f, 0.0f, 0.0f);
 		static constexpr SgTvec3 WORLD_UP = SgTvec3(0.0f, 1.0f, 0.0f);
 		static constexpr SgTvec3 FRONT = SgTvec3(0.0f, 0.0f, -1.0f);
+		static constexpr float ASPECT = 1.0f;
+		static constexpr float NEAR_PLANE = 0.1f;
+		static constexpr float FAR_PLANE = 100.0f;
 		//Camera attributes
 		float Yaw, Pitch, MovementSpeed, MouseSensitivity, Zoom;
 		SgTvec3 Position, Front, Up, Right;
 		const SgTvec3 World_Up;
+		//Projection attributes, the field of view is the zoom degree
+		float Aspect, NearPlane, FarPlane;
+
+		/**
+		 * @brief Advance the version of the camera, must be called whenever the camera attributes have changed
+		*/
+		inline void markDirty() {
+			this->version++;
+		}
+
+	private:
+
+		//The version of the camera, and the versions the cached matrices were calculated at
+		unsigned long long version = 1ull;
+		unsigned long long matrixVersion = 0ull;
+		unsigned long long inverseVersion = 0ull;
+		//Cached matrices
+		SgTmat4 view, projection, viewProjection, inverseView, inverseViewProjection;
+
+		//Snapshots passed to the reader thread, allocated by the first publish so cameras never published stay small, and the version last published
+		std::atomic<SgTTripleBuffer<SgTCameraState>*> snapshot;
+		unsigned long long publishedVersion = 0ull;
+
+		/**
+		 * @brief Recalculate the view, projection, view projection and inverse view matrices if the camera has changed
+		*/
+		void updateMatrix();
 
 	public:
 
@@ -73,6 +121,10 @@ namespace SglToolkit {
 
 		~SgTCamera();
 
+		SgTCamera(const SgTCamera&) = delete;
+
+		SgTCamera& operator=(const SgTCamera&) = delete;
+
 		/**
 		 * @brief Update the camera direction for the keyboard input
 		 * @param direction The direction of movement
@@ -96,11 +148,65 @@ namespace SglToolkit {
 		virtual void scrollUpdate(const float, const SgTRange) = 0;
 
 		/**
-		 * @brief Return the look at camera matrix for the camera
+		 * @brief Return the look at camera matrix for the camera, the matrix is cached until the camera changes
 		 * @return The lookat matrix
 		*/
 		virtual const SgTmat4 getViewMat();
 
+		/**
+		 * @brief Set the perspective projection of the camera, the field of view is the zoom degree
+		 * @param aspect The aspect ratio of the viewport
+		 * @param nearPlane The near plane
+		 * @param farPlane The far plane
+		*/
+		void setProjection(const float, const float, const float);
+
+		/**
+		 * @brief Get the perspective projection matrix, the matrix is cached until the camera changes
+		 * @return The projection matrix
+		*/
+		const SgTmat4& getProjectionMat();
+
+		/**
+		 * @brief Get the projection matrix multiplied by the view matrix, the matrix is cached until the camera changes
+		 * @return The view projection matrix
+		*/
+		const SgTmat4& getViewProjectionMat();
+
+		/**
+		 * @brief Get the inverse of the view matrix, i.e. the camera to world transform, the matrix is cached until the camera changes
+		 * @return The inverse view matrix
+		*/
+		const SgTmat4& getInverseViewMat();
+
+		/**
+		 * @brief Get the inverse of the view projection matrix, e.g. to reconstruct world position from depth.
+		 * The matrix is calculated only when requested, and cached until the camera changes
+		 * @return The inverse view projection matrix
+		*/
+		const SgTmat4& getInverseViewProjectionMat();
+
+		/**
+		 * @brief Get the version of the camera, which is advanced by every update of the camera.
+		 * Anything derived from the camera can be skipped when the version is unchanged
+		 * @return The version
+		*/
+		inline const unsigned long long getVersion() const {
+			return this->version;
+		}
+
+		/**
+		 * @brief Publish the current state of the camera, only called by the thread updating the camera, e.g. once per frame after input is processed.
+		 * Nothing is published if the camera has not changed since the last publish. It never blocks
+		*/
+		void publish();
+
+		/**
+		 * @brief Get the latest published state, only called by one reader thread. It never blocks
+		 * @return The state, which stays unchanged until the next call. The version is 0 if nothing has been published
+		*/
+		const SgTCameraState& acquireSnapshot();
+
 		/**
 		 * @brief Get the current camera front vector
 		 * @return Camera front
@@ -137,6 +243,24 @@ namespace SglToolkit {
 		*/
 		const float getZoomDeg() const;
 
+		/**
+		 * @brief Get the aspect ratio of the projection
+		 * @return The aspect ratio
+		*/
+		const float getAspect() const;
+
+		/**
+		 * @brief Get the near plane of the projection
+		 * @return The near plane
+		*/
+		const float getNearPlane() const;
+
+		/**
+		 * @brief Get the far plane of the projection
+		 * @return The far plane
+		*/
+		const float getFarPlane() const;
+
 	};
 }
 #endif//_SgTCamera_H_
\ No newline at end of file
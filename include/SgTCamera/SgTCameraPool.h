@@ -0,0 +1,165 @@
+#pragma once
+#ifndef _SgTCameraPool_H_
+#define _SgTCameraPool_H_
+
+#include "SgTSpectatorCamera.h"
+
+#include <vector>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Many spectator cameras stored as structure of arrays, so all of them are updated together in vector registers,
+	 * 8 cameras at a time with AVX2 and one at a time otherwise. The cameras behave like SgTSpectatorCamera with world up of (0, 1, 0).
+	 * A frame is usually rotate(), then update() to resolve the camera vectors once, then move() and getViewMat().
+	 * Each attribute is an array aligned to SgTSIMD::ALIGNMENT and padded to a multiple of 8, which can be accessed with getArray().
+	*/
+	class SgTCameraPool {
+	public:
+
+		//The arrays of camera attribute
+		static constexpr unsigned int YAW = 0u;
+		static constexpr unsigned int PITCH = 1u;
+		static constexpr unsigned int ZOOM = 2u;
+		static constexpr unsigned int POSITION_X = 3u;
+		static constexpr unsigned int POSITION_Y = 4u;
+		static constexpr unsigned int POSITION_Z = 5u;
+		static constexpr unsigned int FRONT_X = 6u;
+		static constexpr unsigned int FRONT_Y = 7u;
+		static constexpr unsigned int FRONT_Z = 8u;
+		static constexpr unsigned int RIGHT_X = 9u;
+		static constexpr unsigned int RIGHT_Y = 10u;
+		static constexpr unsigned int RIGHT_Z = 11u;
+		static constexpr unsigned int UP_X = 12u;
+		static constexpr unsigned int UP_Y = 13u;
+		static constexpr unsigned int UP_Z = 14u;
+		static constexpr unsigned int ARRAY_COUNT = 15u;
+
+	private:
+
+		//The maximum number of camera, and the length of each array
+		const size_t Capacity, Stride;
+		size_t count = 0;
+
+		std::vector<float> storage;
+		float* array[SgTCameraPool::ARRAY_COUNT];
+
+	public:
+
+		//setting terms, shared by all cameras
+		float MOVEMENT_SPEED = 2.5f;
+		float MOUSE_SENSITIVITY = 0.1f;
+
+		/**
+		 * @brief Allocate an empty pool, nothing is allocated afterwards
+		 * @param capacity The maximum number of camera
+		*/
+		SgTCameraPool(const size_t);
+
+		~SgTCameraPool();
+
+		SgTCameraPool(const SgTCameraPool&) = delete;
+
+		SgTCameraPool& operator=(const SgTCameraPool&) = delete;
+
+		/**
+		 * @brief Add a camera, the camera vectors are calculated in the next update().
+		 * Throw exception if the pool is full
+		 * @param yaw The initial yaw value for the camera
+		 * @param pitch The initial pitch value for the camera
+		 * @param position The initial position vector for the camera
+		 * @param zoom The initial zoom degree for the camera
+		 * @return The index of the camera
+		*/
+		const size_t add(const float, const float, const SgTvec3, const float = 45.0f);
+
+		/**
+		 * @brief Remove all cameras
+		*/
+		void clear();
+
+		/**
+		 * @brief Update the yaw and pitch of every camera with the mouse offset, the camera vectors are not updated
+		 * @param Xoffset The amount of mouse moved in X of each camera
+		 * @param Yoffset The amount of mouse moved in Y of each camera
+		 * @param limitPitch If set to true, pitch will not go pass 90.0
+		*/
+		void rotate(const float* const, const float* const, const bool = true);
+
+		/**
+		 * @brief Calculate the front, right and up vectors of every camera from yaw and pitch
+		*/
+		void update();
+
+		/**
+		 * @brief Move every camera in the directions held down, along the camera vectors of the last update()
+		 * @param movementMask The movement mask of each camera, see SgTSpectatorCamera::getMovementBit()
+		 * @param deltaTime Frame-based timer, the speed of the movement will also be controlled by the FPS
+		*/
+		void move(const unsigned int* const, const float);
+
+		/**
+		 * @brief Calculate the look at matrix of every camera, from the camera vectors of the last update()
+		 * @param view The view matrix of each camera
+		*/
+		void getViewMat(SgTmat4* const) const;
+
+		/**
+		 * @brief Get an array of camera attribute
+		 * @param attribute The attribute, e.g. YAW or POSITION_X
+		 * @return The array, aligned to SgTSIMD::ALIGNMENT
+		*/
+		inline float* const getArray(const unsigned int attribute) {
+			return this->array[attribute];
+		}
+
+		/**
+		 * @brief Get an array of camera attribute
+		 * @param attribute The attribute, e.g. YAW or POSITION_X
+		 * @return The array, aligned to SgTSIMD::ALIGNMENT
+		*/
+		inline const float* const getArray(const unsigned int attribute) const {
+			return this->array[attribute];
+		}
+
+		/**
+		 * @brief Get the position of a camera
+		 * @param index The index of the camera
+		 * @return The position
+		*/
+		inline const SgTvec3 getPosition(const size_t index) const {
+			return SgTvec3(this->array[SgTCameraPool::POSITION_X][index], this->array[SgTCameraPool::POSITION_Y][index], this->array[SgTCameraPool::POSITION_Z][index]);
+		}
+
+		/**
+		 * @brief Get the front vector of a camera
+		 * @param index The index of the camera
+		 * @return The front
+		*/
+		inline const SgTvec3 getFront(const size_t index) const {
+			return SgTvec3(this->array[SgTCameraPool::FRONT_X][index], this->array[SgTCameraPool::FRONT_Y][index], this->array[SgTCameraPool::FRONT_Z][index]);
+		}
+
+		/**
+		 * @brief Get the up vector of a camera
+		 * @param index The index of the camera
+		 * @return The up
+		*/
+		inline const SgTvec3 getUp(const size_t index) const {
+			return SgTvec3(this->array[SgTCameraPool::UP_X][index], this->array[SgTCameraPool::UP_Y][index], this->array[SgTCameraPool::UP_Z][index]);
+		}
+
+		/**
+		 * @brief Get the number of camera
+		 * @return The number of camera
+		*/
+		inline const size_t getCount() const {
+			return this->count;
+		}
+
+	};
+}
+#endif//_SgTCameraPool_H_
\ No newline at end of file
@@ -3,6 +3,9 @@
 #define _SgTSpectatorCamera_H_
 
 #include "SgTCamera.h"
+#include "../SgTSPSCQueue.h"
+
+#include <atomic>
 
 /**
  * @brief Simple OpenGL Toolkit
@@ -24,8 +27,45 @@ namespace SglToolkit {
 		static const SgTCameraMovement UP = 104u;
 		static const SgTCameraMovement DOWN = 105u;
 
+		/**
+		 * @brief Get the bit of a movement in the movement mask
+		 * @param direction The direction of movement
+		 * @return The bit, or 0 if the direction is unknown
+		*/
+		inline static constexpr unsigned int getMovementBit(const SgTCameraMovement direction) {
+			return (direction >= SgTSpectatorCamera::FORWARD && direction <= SgTSpectatorCamera::DOWN) ? 1u << (direction - SgTSpectatorCamera::FORWARD) : 0u;
+		}
+
 	private:
 
+		/**
+		 * @brief An input event posted by the window thread
+		*/
+		struct SgTCameraInput {
+		public:
+
+			//The kind of event
+			enum class SgTInputType : unsigned char {
+				MOUSE = 0x00u,
+				SCROLL = 0x01u
+			} type;
+			//The cursor position of mouse events, or the offset of scroll events in y
+			float x, y;
+
+		};
+
+		//Input events waiting for the next processInput(), enough for a few frames of a 1000 Hz mouse.
+		//The queue is allocated by the first posted event, so cameras driven by the callback functions stay small
+		typedef SgTSPSCQueue<SgTCameraInput, 1024u> SgTInputQueue;
+		std::atomic<SgTInputQueue*> input;
+		//The directions held down as posted by the window thread. Key state is not queued, so a full queue never loses a release
+		std::atomic<unsigned int> heldMask;
+		//The directions held down in the last processInput(), one bit per movement
+		unsigned int movementMask = 0u;
+		//The last cursor position, and if it has been set
+		float lastX = 0.0f, lastY = 0.0f;
+		bool firstMouse = true;
+
 		/**
 		 * @brief Calculate and update the camera vectors like front, up and right vectors using the existing yaw and pitch values
 		*/
@@ -39,6 +79,36 @@ namespace SglToolkit {
 		*/
 		void procMouseMov(float, float, const bool);
 
+		/**
+		 * @brief Update the yaw and pitch value without updating the camera vectors
+		 * @param Xoffset The amount of mouse moved in X
+		 * @param Yoffset The amount of mouse moved in Y
+		 * @param limitPitch If set to true, pitch will not go pass 90.0
+		*/
+		void procMouseAngle(float, float, const bool);
+
+		/**
+		 * @brief Find the offset of the cursor from the last position, and update the last position
+		 * @param Xpos The X position of the mouse
+		 * @param Ypos The Y position of the mouse
+		 * @return The offset, with Y reversed
+		*/
+		const SgTvec2 procCursor(const float, const float);
+
+		/**
+		 * @brief Push an event to the input queue, only called by the window thread
+		 * @param event The event
+		 * @return False if the input queue is full and the event is dropped
+		*/
+		const bool postInput(const SgTCameraInput&);
+
+		/**
+		 * @brief Update the zoom level without marking the camera changed
+		 * @param Yoffset The input scrolling offset
+		 * @param limitZoom The limit of the zoom
+		*/
+		void procScroll(const float, const SgTRange);
+
 	public:
 
 		/**
@@ -68,7 +138,7 @@ namespace SglToolkit {
 		 * @param direction The direction of movement
 		 * @param deltaTime Frame-based timer, the speed of the movement will also be controlled by the FPS. Providing value of 1 can disable the feature
 		*/
-		void SgTCamera::keyUpdate(const SgTCameraMovement, const float);
+		void keyUpdate(const SgTCameraMovement, const float) override;
 
 		/**
 		 * @brief Update the yaw and pitch value using the mouse position and how much the mouse has moved compare to last frame
@@ -76,14 +146,57 @@ namespace SglToolkit {
 		 * @param Ypos The Y position of the mouse
 		 * @param limitPitch If set to true, pitch will not go pass 90.0
 		*/
-		void SgTCamera::mouseUpdate(const float, const float, const bool);
+		void mouseUpdate(const float, const float, const bool) override;
 
 		/**
 		 * @brief Update the zooming level
 		 * @param Yoffset The input scrolling offset
 		 * @param limitZoom If set then the zoom will be limited
 		*/
-		void SgTCamera::scrollUpdate(const float, const SgTRange = SgTCamera::LIMIT_ZOOM);
+		void scrollUpdate(const float, const SgTRange = SgTCamera::LIMIT_ZOOM) override;
+
+		//These are thread-safe input functions, events are posted by one window thread and processed once per frame by one update thread
+
+		/**
+		 * @brief Post a key event, the camera keeps moving in the direction until the key is released.
+		 * The key state is never dropped, it is picked up by the next processInput()
+		 * @param direction The direction of movement
+		 * @param pressed True if the key is pressed or repeated, false if released
+		 * @return False if the direction is unknown
+		*/
+		const bool postKey(const SgTCameraMovement, const bool);
+
+		/**
+		 * @brief Post a cursor position
+		 * @param Xpos The X position of the mouse
+		 * @param Ypos The Y position of the mouse
+		 * @return False if the input queue is full and the event is dropped
+		*/
+		const bool postMouse(const float, const float);
+
+		/**
+		 * @brief Post a scrolling offset
+		 * @param Yoffset The input scrolling offset
+		 * @return False if the input queue is full and the event is dropped
+		*/
+		const bool postScroll(const float);
+
+		/**
+		 * @brief Apply all posted events at once. Mouse and scroll offsets are summed, and the pitch is limited after the sum.
+		 * The camera moves in every held direction, then the camera vectors are calculated once. The camera is marked changed only if it has changed.
+		 * @param deltaTime Frame-based timer, the speed of the movement will also be controlled by the FPS
+		 * @param limitPitch If set to true, pitch will not go pass 90.0
+		 * @param limitZoom The limit of the zoom
+		*/
+		void processInput(const float, const bool = true, const SgTRange = SgTCamera::LIMIT_ZOOM);
+
+		/**
+		 * @brief Get the directions held down in the last processInput()
+		 * @return The movement mask, see getMovementBit()
+		*/
+		inline const unsigned int getMovementMask() const {
+			return this->movementMask;
+		}
 
 	};
 }
@@ -0,0 +1,169 @@
+#pragma once
+#ifndef _SgTCascadedShadowBox_H_
+#define _SgTCascadedShadowBox_H_
+
+#include "SgTShadowBox.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A shadow box split into cascades along the camera view direction, each cascade has its own orthographic projection
+	 * such that the texel density near the camera is much higher than a single box over SHADOW_DISTANCE.
+	 * Each cascade is fitted with the bounding sphere of its slice of the view frustum, so the projection size does not change when
+	 * the camera rotates, and the projection is snapped to whole shadow map texels, so shadows do not shimmer when the camera moves.
+	 * All cascades share the same light view matrix, which is rotation only.
+	*/
+	class SgTCascadedShadowBox : public SgTShadowBox {
+	public:
+
+		//The maximum number of cascade
+		static constexpr unsigned int MAX_CASCADE = 8u;
+
+		/**
+		 * @brief The data of all cascades laid out for a std140 uniform block, which can be uploaded with a single glBufferSubData:
+		 * layout(std140) uniform Cascade { mat4 lightViewProjection[MAX_CASCADE]; vec4 split[MAX_CASCADE]; int count; };
+		*/
+		struct SgTCascadeBlock {
+		public:
+
+			SgTmat4 lightViewProjection[SgTCascadedShadowBox::MAX_CASCADE];
+			//The near and far distance of each cascade from the camera, the world size of a texel, and the depth range of the projection
+			SgTvec4 split[SgTCascadedShadowBox::MAX_CASCADE];
+			GLint count;
+			GLint padding[3];
+
+		};
+
+	private:
+
+		//The number of cascade
+		const unsigned int CascadeCount;
+		//The resolution of the shadow map of each cascade in texel
+		const unsigned int Resolution;
+		//The distance of each split plane from the camera, the first is NEAR_PLANE and the last is SHADOW_DISTANCE
+		float splitDistance[SgTCascadedShadowBox::MAX_CASCADE + 1];
+		//The weight of logarithmic split in the practical split scheme, or negative if the split is supplied
+		float splitLambda = 0.5f;
+
+		//The light view matrix shared by all cascades, and the projection of each cascade
+		SgTmat4 cascadeView;
+		SgTmat4 cascadeProjection[SgTCascadedShadowBox::MAX_CASCADE];
+		SgTCascadeBlock block;
+
+		/**
+		 * @brief Calculate the split distances with the practical split scheme, using the current NEAR_PLANE and SHADOW_DISTANCE
+		*/
+		void calcPracticalSplit();
+
+		/**
+		 * @brief Check that the supplied split still lies within the current NEAR_PLANE and SHADOW_DISTANCE, nothing is checked for the practical split.
+		 * Throw exception if NEAR_PLANE is not before the first split, or SHADOW_DISTANCE is not the last split
+		*/
+		void checkSplit() const;
+
+		/**
+		 * @brief Fit every cascade in one pass over the split planes
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		void fitCascade(const float);
+
+	protected:
+
+		void copyBounds(const SgTShadowBox&, const float) override;
+
+	public:
+
+		/**
+		 * @brief Creates a cascaded shadow box, the split is calculated with the practical split scheme with lambda of 0.5.
+		 * Throw exception if the number of cascade is 0 or more than MAX_CASCADE
+		 * @param camera - The camera for the scene
+		 * @param lightDir - The direction of the light
+		 * @param nearPlane - The near plane of the camera
+		 * @param aspect - The aspect ratio of the camera perspective
+		 * @param cascadeCount - The number of cascade
+		 * @param resolution - The resolution of the shadow map of each cascade in texel
+		*/
+		SgTCascadedShadowBox(SgTCamera* const, const SgTvec3, const float, const float, const unsigned int, const unsigned int);
+
+		~SgTCascadedShadowBox();
+
+		/**
+		 * @brief Use the practical split scheme, which blends logarithmic and uniform split. The split is recalculated on every update
+		 * so it follows the changes of NEAR_PLANE and SHADOW_DISTANCE.
+		 * @param lambda - The weight of logarithmic split from 0 to 1, 1 gives the highest density near the camera
+		*/
+		void setPracticalSplit(const float);
+
+		/**
+		 * @brief Supply the split distances, SHADOW_DISTANCE is set to the last distance.
+		 * The split is not recalculated, so afterwards NEAR_PLANE must stay before the first distance and SHADOW_DISTANCE must not be changed,
+		 * otherwise update() throws exception. Call setSplit() again to change them.
+		 * Throw exception if the distances are not increasing or the first is not beyond NEAR_PLANE
+		 * @param distance - The far distance of each cascade from the camera, there must be as many distances as cascades
+		*/
+		void setSplit(const float* const);
+
+		/**
+		 * @brief Update the whole shadow box as SgTShadowBox does, and then fit every cascade in one pass over the split planes.
+		 * Throw exception if the split supplied by setSplit() no longer matches NEAR_PLANE or SHADOW_DISTANCE, nothing is updated then
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		void update(const float) override;
+
+		/**
+		 * @brief Get the number of cascade
+		 * @return The number of cascade
+		*/
+		inline const unsigned int getCascadeCount() const {
+			return this->CascadeCount;
+		}
+
+		/**
+		 * @brief Get the distance of a split plane from the camera
+		 * @param index - 0 for the near plane, and i for the far plane of the (i - 1)-th cascade
+		 * @return The distance
+		*/
+		inline const float getSplitDistance(const unsigned int index) const {
+			return this->splitDistance[index];
+		}
+
+		/**
+		 * @brief Get the light view matrix shared by all cascades
+		 * @return The light view matrix
+		*/
+		inline const SgTmat4& getCascadeView() const {
+			return this->cascadeView;
+		}
+
+		/**
+		 * @brief Get the projection matrix of a cascade
+		 * @param index - The index of the cascade
+		 * @return The projection matrix
+		*/
+		inline const SgTmat4& getCascadeProjection(const unsigned int index) const {
+			return this->cascadeProjection[index];
+		}
+
+		/**
+		 * @brief Get the light view projection matrix of a cascade
+		 * @param index - The index of the cascade
+		 * @return The light view projection matrix
+		*/
+		inline const SgTmat4& getCascadeViewProjection(const unsigned int index) const {
+			return this->block.lightViewProjection[index];
+		}
+
+		/**
+		 * @brief Get the data of all cascades for a std140 uniform block
+		 * @return The uniform block data, the size is sizeof(SgTCascadeBlock)
+		*/
+		inline const SgTCascadeBlock& getUniformBlock() const {
+			return this->block;
+		}
+
+	};
+}
+#endif//_SgTCascadedShadowBox_H_
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#ifndef _SgTComputePipeline_H_
+#define _SgTComputePipeline_H_
+
+#include "SgTShaderProc.h"
+
+#include <vector>
+#include <unordered_map>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Record a sequence of compute dispatches and replay them with only the memory barriers they need.
+	 * Each dispatch declares which buffers (or textures) it reads and writes, and how it accesses them. A barrier is inserted
+	 * before a dispatch only if it reads or writes something written by an earlier dispatch, and only with the bits of the
+	 * access that needs it. Barriers are derived when a dispatch is added, so submitting the batch is a plain replay.
+	 * Write-after-read is not considered a hazard, since a dispatch does not start before earlier dispatches finish reading.
+	 * The hazard state is kept across submissions, so a batch can depend on the writes of the previous batch.
+	*/
+	class SgTComputePipeline {
+	public:
+
+		//Access of a resource, can be combined
+		static constexpr unsigned int READ = 0x01u;
+		static constexpr unsigned int WRITE = 0x02u;
+		static constexpr unsigned int READ_WRITE = READ | WRITE;
+
+		/**
+		 * @brief A resource accessed by a dispatch
+		*/
+		struct SgTResourceAccess {
+		public:
+
+			//The buffer or texture, resources are identified by handle only, so do not mix buffers and textures with the same name
+			GLuint resource;
+			//READ, WRITE or READ_WRITE
+			unsigned int access;
+			//How the resource is accessed, e.g. GL_SHADER_STORAGE_BARRIER_BIT, GL_SHADER_IMAGE_ACCESS_BARRIER_BIT or GL_UNIFORM_BARRIER_BIT.
+			//For consumers after the batch, e.g. GL_COMMAND_BARRIER_BIT for indirect draw or GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+			GLbitfield usage;
+
+		};
+
+	private:
+
+		/**
+		 * @brief A recorded dispatch
+		*/
+		struct SgTDispatch {
+		public:
+
+			//The program, null if it only issues a barrier
+			const SgTShaderProc* program;
+			//The number of work group, or the indirect buffer and offset
+			GLuint groupCount[3];
+			GLuint indirectBuffer;
+			GLintptr indirectOffset;
+			//The callback to set uniforms after the program is bound, can be null
+			SgTProgramPara arg;
+			//The barrier to be issued before the dispatch, 0 if none
+			GLbitfield barrier;
+
+		};
+		std::vector<SgTDispatch> dispatch;
+
+		//Resources written by recorded dispatches, and the barrier bits issued since the last write of each
+		std::unordered_map<GLuint, GLbitfield> hazard;
+		//The hazard state as of the last submission, restored when recorded dispatches are discarded
+		std::unordered_map<GLuint, GLbitfield> submittedHazard;
+
+		/**
+		 * @brief Find the barrier needed by a dispatch, and update the hazard state
+		 * @param access The resources accessed
+		 * @param count The number of resource
+		 * @return The barrier bits
+		*/
+		const GLbitfield resolveHazard(const SgTResourceAccess* const, const size_t);
+
+	public:
+
+		/**
+		 * @brief Initialise an empty batch
+		*/
+		SgTComputePipeline();
+
+		~SgTComputePipeline();
+
+		/**
+		 * @brief Get the local work group size of a linked compute program.
+		 * Throw exception if the program does not contain a compute shader
+		 * @param program The program
+		 * @return The pointer to the size in x, y and z
+		*/
+		static const GLint* const getWorkGroupSize(const SgTShaderProc&);
+
+		/**
+		 * @brief Calculate the number of work group to cover all elements, each dimension is rounded up.
+		 * Throw exception if the program does not contain a compute shader, or the count exceeds GL_MAX_COMPUTE_WORK_GROUP_COUNT
+		 * @param program The compute program
+		 * @param element The number of element in x, y and z
+		 * @param group The number of work group in x, y and z
+		*/
+		static void getGroupCount(const SgTShaderProc&, const GLuint* const, GLuint* const);
+
+		/**
+		 * @brief Record a dispatch with the number of work group
+		 * @param program The linked compute program, it must outlive the batch
+		 * @param group The number of work group in x, y and z
+		 * @param access The resources accessed by the dispatch
+		 * @param count The number of resource
+		 * @param arg The callback to set uniforms after the program is bound, supplied with the program
+		*/
+		void addDispatch(const SgTShaderProc&, const GLuint* const, const SgTResourceAccess* const, const size_t, SgTProgramPara = NULL);
+
+		/**
+		 * @brief Record a dispatch that covers a number of element, the number of work group is derived from the work group size
+		 * @param program The linked compute program, it must outlive the batch
+		 * @param element The number of element in x, y and z
+		 * @param access The resources accessed by the dispatch
+		 * @param count The number of resource
+		 * @param arg The callback to set uniforms after the program is bound, supplied with the program
+		*/
+		void addDispatchElement(const SgTShaderProc&, const GLuint* const, const SgTResourceAccess* const, const size_t, SgTProgramPara = NULL);
+
+		/**
+		 * @brief Record a dispatch with the number of work group read from a buffer, the buffer is read as GL_COMMAND_BARRIER_BIT
+		 * @param program The linked compute program, it must outlive the batch
+		 * @param buffer The buffer containing the number of work group
+		 * @param offset The byte offset of the number in the buffer
+		 * @param access The resources accessed by the dispatch
+		 * @param count The number of resource
+		 * @param arg The callback to set uniforms after the program is bound, supplied with the program
+		*/
+		void addDispatchIndirect(const SgTShaderProc&, const GLuint, const GLintptr, const SgTResourceAccess* const, const size_t, SgTProgramPara = NULL);
+
+		/**
+		 * @brief Declare how resources are used after the batch, e.g. by draw calls, so the required barrier is issued at that point
+		 * @param access The resources to be accessed
+		 * @param count The number of resource
+		*/
+		void addConsumer(const SgTResourceAccess* const, const size_t);
+
+		/**
+		 * @brief Issue all recorded dispatches and barriers, the recorded dispatches are then cleared.
+		 * The current program is changed.
+		*/
+		void submit();
+
+		/**
+		 * @brief Discard all recorded dispatches that have not been submitted, hazard state goes back to the last submission
+		*/
+		void clear();
+
+		/**
+		 * @brief Forget all hazards, e.g. after a barrier is issued outside the batch
+		*/
+		void resetHazard();
+
+		/**
+		 * @brief Get the number of dispatch recorded
+		 * @return The number of dispatch, including consumers
+		*/
+		inline const size_t getDispatchCount() const {
+			return this->dispatch.size();
+		}
+
+	};
+}
+#endif//_SgTComputePipeline_H_
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+#ifndef _SgTCubeShadowBox_H_
+#define _SgTCubeShadowBox_H_
+
+#include "SgTDefineFile.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Represents the volume in which objects cast shadows of a point light, which is covered by the six faces of a cube shadow map.
+	 * Each face is a perspective projection with 90 degree field of view looking along one axis, in the order of the cube map faces,
+	 * i.e. GL_TEXTURE_CUBE_MAP_POSITIVE_X + index, so the matrices can be uploaded as an array for layered rendering.
+	 * The rotation of the faces never changes, so only the translation of the light is applied on update, for all faces at once in vector registers.
+	 * Objects can be culled per face, such that each object is drawn only into the faces it touches.
+	*/
+	class SgTCubeShadowBox {
+	public:
+
+		//The number of face of a cube
+		static constexpr unsigned int FACE_COUNT = 6u;
+
+	private:
+
+		//The position of the light, and the depth range of the projection
+		SgTvec3 Position;
+		float NearPlane, FarPlane;
+
+		//The view projection of each face with the light at the origin, stored as structure of arrays:
+		//column c of face f row r is at base[c][f * 4 + r], so each column of all faces fills three vector registers
+		alignas(32) float base[4][SgTCubeShadowBox::FACE_COUNT * 4];
+		SgTmat4 projection;
+		SgTmat4 faceViewProjection[SgTCubeShadowBox::FACE_COUNT];
+
+		/**
+		 * @brief Calculate the view projection of each face with the light at the origin, which only depends on the depth range
+		*/
+		void calcBase();
+
+	public:
+
+		/**
+		 * @brief Creates a cube shadow box.
+		 * Throw exception if the near plane is not positive, or the far plane is not beyond the near plane
+		 * @param position - The position of the point light
+		 * @param nearPlane - The near plane of the projection of each face
+		 * @param farPlane - The far plane of the projection of each face, which is the range of the light
+		*/
+		SgTCubeShadowBox(const SgTvec3, const float, const float);
+
+		~SgTCubeShadowBox();
+
+		/**
+		 * @brief Set the position of the light, the box needs to be updated
+		 * @param position - The position of the point light
+		*/
+		void setPosition(const SgTvec3);
+
+		/**
+		 * @brief Set the depth range of the projection, the box needs to be updated.
+		 * Throw exception if the near plane is not positive, or the far plane is not beyond the near plane
+		 * @param nearPlane - The near plane of the projection of each face
+		 * @param farPlane - The far plane of the projection of each face
+		*/
+		void setDepthRange(const float, const float);
+
+		/**
+		 * @brief Calculate the view projection matrices of all faces
+		*/
+		void update();
+
+		/**
+		 * @brief Find the faces each object is drawn into, from the axis-aligned bounding boxes of objects.
+		 * An object beyond the range of the light is not drawn into any face. The test is conservative at the edges of the faces.
+		 * @param min - The minimum corner of the bounding box of each object in world space
+		 * @param max - The maximum corner of the bounding box of each object in world space
+		 * @param count - The number of object
+		 * @param mask - The faces of each object, bit i is set if the object is drawn into face i
+		*/
+		void cullFace(const SgTvec3* const, const SgTvec3* const, const size_t, unsigned char* const) const;
+
+		/**
+		 * @brief Get the view projection matrix of a face
+		 * @param index - The index of the face
+		 * @return The light view projection matrix
+		*/
+		inline const SgTmat4& getFaceViewProjection(const unsigned int index) const {
+			return this->faceViewProjection[index];
+		}
+
+		/**
+		 * @brief Get the view projection matrices of all faces, which are contiguous
+		 * @return The pointer to FACE_COUNT matrices
+		*/
+		inline const SgTmat4* const getViewProjection() const {
+			return this->faceViewProjection;
+		}
+
+		/**
+		 * @brief Get the projection matrix shared by all faces
+		 * @return The light projection matrix
+		*/
+		inline const SgTmat4& getProjection() const {
+			return this->projection;
+		}
+
+		/**
+		 * @brief Get the position of the light
+		 * @return The position
+		*/
+		inline const SgTvec3 getPosition() const {
+			return this->Position;
+		}
+
+		/**
+		 * @brief Get the near plane of the projection
+		 * @return The near plane
+		*/
+		inline const float getNearPlane() const {
+			return this->NearPlane;
+		}
+
+		/**
+		 * @brief Get the far plane of the projection, which is the range of the light
+		 * @return The far plane
+		*/
+		inline const float getFarPlane() const {
+			return this->FarPlane;
+		}
+
+	};
+}
+#endif//_SgTCubeShadowBox_H_
\ No newline at end of file
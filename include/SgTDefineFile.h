@@ -28,6 +28,10 @@ namespace SglToolkit {
 	typedef glm::mat3 SgTmat3;
 	typedef glm::mat4 SgTmat4;
 	typedef std::string SgTstring;
+	/**
+	 * @brief A 64-bit hash code, used to identify shader sources, programs and names
+	*/
+	typedef unsigned long long SgTHash;
 
 	/*
 	The SgTShaderStatus indicates the status returned when user tries to compile the shader and link their programe
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef _SgTFileMapping_H_
+#define _SgTFileMapping_H_
+
+#include "SgTDefineFile.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A read-only memory mapping of an entire file.
+	 * The content can be accessed directly without being copied into user memory, the file is unmapped when the mapping is destroyed.
+	*/
+	class SgTFileMapping {
+	private:
+
+		//The start of the mapped memory, or null if nothing is mapped
+		const char* address = nullptr;
+		//The number of byte being mapped
+		size_t length = 0;
+#ifdef _WIN32
+		//The mapping object
+		void* mappingHandle = nullptr;
+#endif
+
+		/**
+		 * @brief Unmap the file if it is mapped
+		*/
+		void unmap();
+
+	public:
+
+		/**
+		 * @brief Initialise an empty mapping
+		*/
+		SgTFileMapping();
+
+		/**
+		 * @brief Map the whole file into memory.
+		 * Throw exception if the file cannot be opened or mapped
+		 * @param path The path of the file
+		*/
+		SgTFileMapping(const SgTstring);
+
+		SgTFileMapping(const SgTFileMapping&) = delete;
+
+		SgTFileMapping(SgTFileMapping&&) noexcept;
+
+		SgTFileMapping& operator=(const SgTFileMapping&) = delete;
+
+		SgTFileMapping& operator=(SgTFileMapping&&) noexcept;
+
+		~SgTFileMapping();
+
+		/**
+		 * @brief Get the mapped content.
+		 * Note that the content is not null-terminated.
+		 * @return The pointer to the first byte of the file
+		*/
+		inline const char* getData() const {
+			//empty file is not mapped, but it is still a valid empty string
+			return this->address == nullptr ? "" : this->address;
+		}
+
+		/**
+		 * @brief Get the size of the mapped content
+		 * @return The number of byte in the file
+		*/
+		inline const size_t getLength() const {
+			return this->length;
+		}
+
+	};
+}
+#endif//_SgTFileMapping_H_
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+#ifndef _SgTFrustumCuller_H_
+#define _SgTFrustumCuller_H_
+
+#include "SgTCamera/SgTCamera.h"
+#include "SgTShadowBox.h"
+
+#include <functional>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Cull bounding volumes against the six planes of a view frustum, extracted from a camera view-projection or the light matrix of a shadow box.
+	 * Objects are given as structure of arrays and tested 8 at a time with AVX or 4 at a time with SSE, the visible objects are written as a compact list of index
+	 * in ascending order, ready for draw submission. Large arrays are split into chunks culled by worker threads.
+	 * An optional plane cache stores, for each object, the plane that rejected it last time. Since objects rarely move across a plane between
+	 * frames, that plane is tested first and a block of rejected objects is skipped after a single plane test.
+	*/
+	class SgTFrustumCuller {
+	public:
+
+		//The number of frustum plane
+		static constexpr unsigned int PLANE_COUNT = 6u;
+		//The plane cache value of an object that was visible
+		static constexpr unsigned char NO_PLANE = 6u;
+
+		/**
+		 * @brief Bounding spheres as structure of arrays
+		*/
+		struct SgTSphereArray {
+		public:
+
+			const float* x;
+			const float* y;
+			const float* z;
+			const float* radius;
+
+		};
+
+		/**
+		 * @brief Axis aligned bounding boxes as structure of arrays
+		*/
+		struct SgTBoxArray {
+		public:
+
+			const float* minX;
+			const float* minY;
+			const float* minZ;
+			const float* maxX;
+			const float* maxY;
+			const float* maxZ;
+
+		};
+
+	private:
+
+		//The planes in the order of near, far, left, right, top and bottom
+		SgTvec4 plane[SgTFrustumCuller::PLANE_COUNT];
+		//The coefficients a, b, c, d, |a|, |b| and |c| of each plane in a row, the 2 lanes after the planes never reject anything
+		alignas(32) float coefficient[7][8];
+
+		/**
+		 * @brief Cull a range of spheres
+		 * @param sphere - The spheres
+		 * @param begin - The first sphere
+		 * @param end - One past the last sphere
+		 * @param cache - The plane cache, or nullptr
+		 * @param index - The index of the visible spheres
+		 * @return The number of visible sphere
+		*/
+		const size_t cullSphereRange(const SgTSphereArray&, const size_t, const size_t, unsigned char* const, unsigned int* const) const;
+
+		/**
+		 * @brief Cull a range of boxes
+		 * @param box - The boxes
+		 * @param begin - The first box
+		 * @param end - One past the last box
+		 * @param cache - The plane cache, or nullptr
+		 * @param index - The index of the visible boxes
+		 * @return The number of visible box
+		*/
+		const size_t cullBoxRange(const SgTBoxArray&, const size_t, const size_t, unsigned char* const, unsigned int* const) const;
+
+		/**
+		 * @brief Run the culling over all objects, split into chunks across worker threads if there are enough objects
+		 * @param count - The number of object
+		 * @param index - The index of the visible objects
+		 * @param range - Cull a range of object and write the visible index from the given output, return the number of visible object
+		 * @return The number of visible object
+		*/
+		const size_t dispatch(const size_t, unsigned int* const,
+			const std::function<const size_t(const size_t, const size_t, unsigned int* const)>&) const;
+
+	public:
+
+		//setting terms
+		//The maximum number of thread culling at the same time, including the calling thread
+		unsigned int THREAD_COUNT;
+		//The minimum number of object in each chunk, smaller arrays are culled by the calling thread only
+		size_t CHUNK_SIZE = 65536u;
+
+		/**
+		 * @brief Creates a culler, the frustum is the clip space cube until setFrustum() is called
+		*/
+		SgTFrustumCuller();
+
+		~SgTFrustumCuller();
+
+		/**
+		 * @brief Extract the frustum planes from a matrix that maps world space into OpenGL clip space
+		 * @param matrix - The matrix, e.g. the view-projection matrix
+		*/
+		void setFrustum(const SgTmat4&);
+
+		/**
+		 * @brief Extract the frustum planes from the view-projection matrix of a camera
+		 * @param camera - The camera
+		*/
+		void setFrustum(SgTCamera&);
+
+		/**
+		 * @brief Extract the frustum planes from the light matrix of a shadow box, which is the box in world space
+		 * @param shadowBox - The shadow box, which should be updated
+		*/
+		void setFrustum(SgTShadowBox&);
+
+		/**
+		 * @brief Find the visible spheres, a sphere is visible if it is not entirely outside any plane.
+		 * The arrays do not need to be aligned
+		 * @param sphere - The spheres
+		 * @param count - The number of sphere
+		 * @param index - The index of the visible spheres in ascending order, with enough space for count index
+		 * @param cache - The plane cache with one byte per sphere kept between frames, or nullptr to test all planes.
+		 * Any initial value is valid, the result is the same with or without cache
+		 * @return The number of visible sphere
+		*/
+		const size_t cullSphere(const SgTSphereArray&, const size_t, unsigned int* const, unsigned char* const = nullptr) const;
+
+		/**
+		 * @brief Find the visible boxes, a box is visible if it is not entirely outside any plane.
+		 * The arrays do not need to be aligned
+		 * @param box - The boxes
+		 * @param count - The number of box
+		 * @param index - The index of the visible boxes in ascending order, with enough space for count index
+		 * @param cache - The plane cache with one byte per box kept between frames, or nullptr to test all planes.
+		 * Any initial value is valid, the result is the same with or without cache
+		 * @return The number of visible box
+		*/
+		const size_t cullBox(const SgTBoxArray&, const size_t, unsigned int* const, unsigned char* const = nullptr) const;
+
+		/**
+		 * @brief Get a frustum plane
+		 * @param index - The index of the plane, in the order of near, far, left, right, top and bottom
+		 * @return The plane (a, b, c, d) with unit normal such that ax + by + cz + d >= 0 is inside the frustum
+		*/
+		inline const SgTvec4& getPlane(const unsigned int index) const {
+			return this->plane[index];
+		}
+
+	};
+}
+#endif//_SgTFrustumCuller_H_
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef _SgTMultiViewShadowBox_H_
+#define _SgTMultiViewShadowBox_H_
+
+#include "SgTShadowBox.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A shadow box fitted over the view frustums of several cameras, e.g. the two eyes in stereo or the views in split screen,
+	 * so a single shadow map is rendered for all of them. The bounds are the union of the bounds of every view in light space.
+	 * When the views are far apart the union becomes much larger than each view and the shadow resolution drops, the share ratio tells
+	 * whether the union is still small enough to be shared, otherwise a shadow box per view should be used.
+	 * All cameras use the same settings and aspect ratio. The first camera is the camera of the shadow box.
+	*/
+	class SgTMultiViewShadowBox : public SgTShadowBox {
+	public:
+
+		//The maximum number of view
+		static constexpr unsigned int MAX_VIEW = 4u;
+
+	private:
+
+		//The cameras, and the number of camera
+		SgTCamera* View[SgTMultiViewShadowBox::MAX_VIEW];
+		const unsigned int ViewCount;
+
+		//The planes of the view frustum of each camera
+		SgTvec4 viewPlane[SgTMultiViewShadowBox::MAX_VIEW * 6];
+		//The area of the union across the light over the area of the largest view
+		float shareRatio = 1.0f;
+
+		/**
+		 * @brief The state of a camera when the bounds are computed
+		*/
+		struct SgTViewState {
+		public:
+
+			SgTvec3 position, front, up;
+			float zoom;
+
+		};
+		SgTViewState lastView[SgTMultiViewShadowBox::MAX_VIEW];
+
+		/**
+		 * @brief Get the first camera, throw exception if the number of camera is 0 or more than MAX_VIEW
+		 * @param camera - The cameras
+		 * @param count - The number of camera
+		 * @return The first camera
+		*/
+		static SgTCamera* const getFirstView(SgTCamera* const* const, const unsigned int);
+
+	protected:
+
+		const bool hasSameFrustum(const SgTShadowBox&) const override;
+
+		const bool reuseBounds(const float) override;
+
+	public:
+
+		/**
+		 * @brief Creates a shadow box over several cameras.
+		 * Throw exception if the number of camera is 0 or more than MAX_VIEW
+		 * @param camera - The cameras
+		 * @param count - The number of camera
+		 * @param lightDir - The direction of the light
+		 * @param nearPlane - The near plane of the cameras
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		SgTMultiViewShadowBox(SgTCamera* const* const, const unsigned int, const SgTvec3, const float, const float);
+
+		~SgTMultiViewShadowBox();
+
+		/**
+		 * @brief Updates the bounds to the union of the bounds of all views in light space, which is then clipped against the scene bounds
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		void update(const float) override;
+
+		/**
+		 * @brief Find the shadow casters, an object is a caster if its extrusion along the light direction intersects any of the view frustums.
+		 * See SgTShadowBox::cullCaster()
+		*/
+		const size_t cullCaster(const SgTvec3* const, const SgTvec3* const, const size_t, unsigned int* const) const override;
+
+		/**
+		 * @brief Get the area of the union of all views across the light over the area of the largest view, before clipping against the scene.
+		 * The resolution of the shared shadow map is lower than a shadow map of the largest view by the square root of the ratio
+		 * @return The ratio, which is at least 1
+		*/
+		inline const float getShareRatio() const {
+			return this->shareRatio;
+		}
+
+		/**
+		 * @brief Check if the union of all views is small enough to share a single shadow map
+		 * @param maxRatio - The maximum share ratio allowed, e.g. 1.5 loses about 20% resolution in each direction
+		 * @return True if the shadow map can be shared
+		*/
+		inline const bool isShareable(const float maxRatio) const {
+			return this->shareRatio <= maxRatio;
+		}
+
+		/**
+		 * @brief Get the number of camera
+		 * @return The number of camera
+		*/
+		inline const unsigned int getViewCount() const {
+			return this->ViewCount;
+		}
+
+	};
+}
+#endif//_SgTMultiViewShadowBox_H_
\ No newline at end of file
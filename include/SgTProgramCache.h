@@ -0,0 +1,110 @@
+#pragma once
+#ifndef _SgTProgramCache_H_
+#define _SgTProgramCache_H_
+
+#include "SgTDefineFile.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief An on-disk cache of linked program binaries.
+	 * Programs are identified by a key that is computed from every stage source, the stage types, the pre-link settings and
+	 * the driver strings, such that a driver update or a source change will never pick up a stale binary.
+	 * All functions must be called from the thread that holds the OpenGL context.
+	*/
+	class SgTProgramCache {
+	public:
+
+		/**
+		 * @brief The number of cache hit, miss and rejected binaries since the cache was created or reset
+		*/
+		struct SgTCacheStat {
+		public:
+
+			//Binary found and accepted by the driver
+			unsigned int hit;
+			//Binary not found, program needs to be compiled
+			unsigned int miss;
+			//Binary found but the driver refuses to load it, program needs to be compiled
+			unsigned int reject;
+
+		};
+
+	private:
+
+		//Identify the cache file
+		static constexpr unsigned int MAGIC = 0x50546753u;//"SgTP"
+
+		//The directory where binaries are stored
+		const SgTstring Directory;
+		//The hash of the driver vendor, renderer and version strings, queried on first use
+		SgTHash driverHash = 0ull;
+		//Set to true if the driver supports at least one binary format
+		bool binarySupported = false;
+		bool driverQueried = false;
+
+		SgTCacheStat stat = { 0u, 0u, 0u };
+
+		/**
+		 * @brief Query the driver strings and binary format support if it has not been done
+		*/
+		void queryDriver();
+
+		/**
+		 * @brief Get the file path of the binary for the key
+		 * @param key The program key
+		 * @return The file path
+		*/
+		const SgTstring getCachePath(const SgTHash) const;
+
+	public:
+
+		/**
+		 * @brief Initialise the program cache, the directory will be created when the first binary is stored
+		 * @param directory The directory where program binaries are stored
+		*/
+		SgTProgramCache(const SgTstring);
+
+		~SgTProgramCache();
+
+		/**
+		 * @brief Get the hash of the driver vendor, renderer and version strings.
+		 * Program key should always be started with this hash.
+		 * @return The driver hash
+		*/
+		const SgTHash getDriverHash();
+
+		/**
+		 * @brief Try to load a program binary with the key.
+		 * If the binary is rejected by the driver, the cached file will be removed.
+		 * @param program The program to be loaded
+		 * @param key The program key
+		 * @return True if the program is loaded and linked successfully. Otherwise the program needs to be compiled normally
+		*/
+		const bool loadProgram(const GLuint, const SgTHash);
+
+		/**
+		 * @brief Store the binary of a successfully linked program.
+		 * For best result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT should be set before the program is linked.
+		 * @param program The linked program
+		 * @param key The program key
+		*/
+		void storeProgram(const GLuint, const SgTHash);
+
+		/**
+		 * @brief Get the hit, miss and reject counts
+		 * @return The cache statistics
+		*/
+		const SgTCacheStat getStat() const;
+
+		/**
+		 * @brief Reset all counts to zero
+		*/
+		void resetStat();
+
+	};
+}
+#endif//_SgTProgramCache_H_
\ No newline at end of file
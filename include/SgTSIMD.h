@@ -0,0 +1,187 @@
+#pragma once
+#ifndef _SgTSIMD_H_
+#define _SgTSIMD_H_
+
+//Select the widest instruction set enabled by the compiler, the scalar path is always available
+#if defined(__AVX__)
+#define SgT_SIMD_AVX
+#include <immintrin.h>
+//integer vector operations for bit manipulation
+#if defined(__AVX2__)
+#define SgT_SIMD_AVX2
+#endif
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SgT_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Small vector kernels shared by the toolkit, written for AVX and SSE with a scalar fallback.
+	 * Arrays passed to these kernels should be aligned to SgTSIMD::ALIGNMENT for the aligned load.
+	*/
+	struct SgTSIMD {
+	private:
+
+		/**
+		 * @brief This is a full-static struct and should not be instanciated
+		*/
+		SgTSIMD() {
+
+		}
+
+		~SgTSIMD() {
+
+		}
+
+	public:
+
+		//The alignment required by the widest register
+		static constexpr size_t ALIGNMENT = 32u;
+
+		/**
+		 * @brief Find the minimum and maximum of 8 floats without branching
+		 * @param value The 8 floats, aligned to ALIGNMENT
+		 * @param min The minimum
+		 * @param max The maximum
+		*/
+		inline static void minMax8(const float* const value, float& min, float& max) {
+#if defined(SgT_SIMD_AVX)
+			const __m256 v = _mm256_load_ps(value);
+			//fold the upper half onto the lower half, then pairs, then neighbours
+			__m128 lo = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+			__m128 hi = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+			lo = _mm_min_ps(lo, _mm_movehl_ps(lo, lo));
+			hi = _mm_max_ps(hi, _mm_movehl_ps(hi, hi));
+			lo = _mm_min_ss(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 1, 1, 1)));
+			hi = _mm_max_ss(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 1, 1, 1)));
+			min = _mm_cvtss_f32(lo);
+			max = _mm_cvtss_f32(hi);
+#elif defined(SgT_SIMD_SSE)
+			const __m128 a = _mm_load_ps(value), b = _mm_load_ps(value + 4);
+			__m128 lo = _mm_min_ps(a, b);
+			__m128 hi = _mm_max_ps(a, b);
+			lo = _mm_min_ps(lo, _mm_movehl_ps(lo, lo));
+			hi = _mm_max_ps(hi, _mm_movehl_ps(hi, hi));
+			lo = _mm_min_ss(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 1, 1, 1)));
+			hi = _mm_max_ss(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 1, 1, 1)));
+			min = _mm_cvtss_f32(lo);
+			max = _mm_cvtss_f32(hi);
+#else
+			min = value[0];
+			max = value[0];
+			for (int i = 1; i < 8; i++) {
+				min = std::min(min, value[i]);
+				max = std::max(max, value[i]);
+			}
+#endif
+		}
+
+		/**
+		 * @brief Transform 8 points by an affine matrix, points are stored as structure of arrays
+		 * @param matrix The column-major 4x4 matrix, the last row is assumed to be (0, 0, 0, 1)
+		 * @param x, y, z The coordinates of the points, aligned to ALIGNMENT
+		 * @param outX, outY, outZ The transformed coordinates, aligned to ALIGNMENT, may be the same as the input
+		*/
+		inline static void transform8(const float* const matrix, const float* const x, const float* const y, const float* const z,
+			float* const outX, float* const outY, float* const outZ) {
+#if defined(SgT_SIMD_AVX)
+			const __m256 vx = _mm256_load_ps(x), vy = _mm256_load_ps(y), vz = _mm256_load_ps(z);
+			float* const out[3] = { outX, outY, outZ };
+			for (int r = 0; r < 3; r++) {
+				__m256 v = _mm256_add_ps(_mm256_mul_ps(vx, _mm256_set1_ps(matrix[r])), _mm256_mul_ps(vy, _mm256_set1_ps(matrix[4 + r])));
+				v = _mm256_add_ps(v, _mm256_add_ps(_mm256_mul_ps(vz, _mm256_set1_ps(matrix[8 + r])), _mm256_set1_ps(matrix[12 + r])));
+				_mm256_store_ps(out[r], v);
+			}
+#elif defined(SgT_SIMD_SSE)
+			for (int h = 0; h < 8; h += 4) {
+				const __m128 vx = _mm_load_ps(x + h), vy = _mm_load_ps(y + h), vz = _mm_load_ps(z + h);
+				float* const out[3] = { outX + h, outY + h, outZ + h };
+				for (int r = 0; r < 3; r++) {
+					__m128 v = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(matrix[r])), _mm_mul_ps(vy, _mm_set1_ps(matrix[4 + r])));
+					v = _mm_add_ps(v, _mm_add_ps(_mm_mul_ps(vz, _mm_set1_ps(matrix[8 + r])), _mm_set1_ps(matrix[12 + r])));
+					_mm_store_ps(out[r], v);
+				}
+			}
+#else
+			for (int i = 0; i < 8; i++) {
+				const float px = x[i], py = y[i], pz = z[i];
+				outX[i] = matrix[0] * px + matrix[4] * py + matrix[8] * pz + matrix[12];
+				outY[i] = matrix[1] * px + matrix[5] * py + matrix[9] * pz + matrix[13];
+				outZ[i] = matrix[2] * px + matrix[6] * py + matrix[10] * pz + matrix[14];
+			}
+#endif
+		}
+
+#if defined(SgT_SIMD_AVX2)
+		/**
+		 * @brief Calculate sine and cosine of 8 angles at once, the absolute error is within 1e-7 for angles up to a few thousand radians.
+		 * The angle is reduced into [-pi/4, pi/4] with an extended precision pi/4, and both polynomials are evaluated for all lanes
+		 * @param x The angles in radian
+		 * @param s The sine
+		 * @param c The cosine
+		*/
+		inline static void sincos8(const __m256 x, __m256& s, __m256& c) {
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			__m256 signSin = _mm256_and_ps(x, signMask);
+			__m256 a = _mm256_andnot_ps(signMask, x);
+
+			//the octant, rounded to even so the reduced angle is in [-pi/4, pi/4]
+			__m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(a, _mm256_set1_ps(1.27323954473516f)));
+			octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+			const __m256 y = _mm256_cvtepi32_ps(octant);
+			const __m256i swapSin = _mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29);
+			const __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+			const __m256i signCos = _mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29);
+			signSin = _mm256_xor_ps(signSin, _mm256_castsi256_ps(swapSin));
+
+			a = _mm256_add_ps(a, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+			a = _mm256_add_ps(a, _mm256_mul_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f)));
+			a = _mm256_add_ps(a, _mm256_mul_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f)));
+			const __m256 z = _mm256_mul_ps(a, a);
+
+			//cosine and sine polynomials on [-pi/4, pi/4]
+			__m256 pc = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), z), _mm256_set1_ps(-1.388731625493765e-3f));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(4.166664568298827e-2f));
+			pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+			pc = _mm256_add_ps(_mm256_sub_ps(pc, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+			__m256 ps = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), z), _mm256_set1_ps(8.3321608736e-3f));
+			ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(-1.6666654611e-1f));
+			ps = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, z), a), a);
+
+			//odd octants swap the polynomials
+			s = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, polyMask), signSin);
+			c = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, polyMask), _mm256_castsi256_ps(signCos));
+		}
+#endif
+
+		/**
+		 * @brief Calculate sine and cosine of 8 angles at once
+		 * @param x The angles in radian, aligned to ALIGNMENT
+		 * @param s The sine, aligned to ALIGNMENT
+		 * @param c The cosine, aligned to ALIGNMENT
+		*/
+		inline static void sincos8(const float* const x, float* const s, float* const c) {
+#if defined(SgT_SIMD_AVX2)
+			__m256 vs, vc;
+			SgTSIMD::sincos8(_mm256_load_ps(x), vs, vc);
+			_mm256_store_ps(s, vs);
+			_mm256_store_ps(c, vc);
+#else
+			for (int i = 0; i < 8; i++) {
+				s[i] = std::sin(x[i]);
+				c[i] = std::cos(x[i]);
+			}
+#endif
+		}
+
+	};
+}
+#endif//_SgTSIMD_H_
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef _SgTSPSCQueue_H_
+#define _SgTSPSCQueue_H_
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A bounded lock-free queue with a single producer thread and a single consumer thread, e.g. input events from the window thread
+	 * to the update thread. Elements are stored in a fixed ring buffer, so nothing is allocated after construction.
+	 * The producer and consumer indices live on separate cache lines, and each side caches the index of the other side, so the shared
+	 * cache line is only read when the queue looks full or empty.
+	 * @tparam T The element type, which should be trivially copyable
+	 * @tparam Capacity The number of element, which must be a power of two
+	*/
+	template<typename T, size_t Capacity>
+	class SgTSPSCQueue {
+	private:
+
+		static_assert(Capacity != 0u && (Capacity & (Capacity - 1u)) == 0u, "The capacity must be a power of two");
+		static constexpr size_t MASK = Capacity - 1u;
+		static constexpr size_t CACHE_LINE = 64u;
+
+		//The index of the next element to pop, written by the consumer, and the cached tail of the consumer
+		alignas(CACHE_LINE) std::atomic<size_t> head;
+		size_t cachedTail;
+		//The index of the next element to push, written by the producer, and the cached head of the producer
+		alignas(CACHE_LINE) std::atomic<size_t> tail;
+		size_t cachedHead;
+
+		alignas(CACHE_LINE) T buffer[Capacity];
+
+	public:
+
+		/**
+		 * @brief Initialise an empty queue
+		*/
+		SgTSPSCQueue() : head(0u), cachedTail(0u), tail(0u), cachedHead(0u) {
+
+		}
+
+		~SgTSPSCQueue() {
+
+		}
+
+		SgTSPSCQueue(const SgTSPSCQueue&) = delete;
+
+		SgTSPSCQueue& operator=(const SgTSPSCQueue&) = delete;
+
+		/**
+		 * @brief Push an element, only called by the producer thread
+		 * @param value The element
+		 * @return False if the queue is full, the element is dropped
+		*/
+		inline const bool push(const T& value) {
+			const size_t t = this->tail.load(std::memory_order_relaxed);
+			if (t - this->cachedHead == Capacity) {
+				this->cachedHead = this->head.load(std::memory_order_acquire);
+				if (t - this->cachedHead == Capacity) {
+					return false;
+				}
+			}
+			this->buffer[t & MASK] = value;
+			this->tail.store(t + 1u, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Pop an element, only called by the consumer thread
+		 * @param value The element
+		 * @return False if the queue is empty
+		*/
+		inline const bool pop(T& value) {
+			const size_t h = this->head.load(std::memory_order_relaxed);
+			if (h == this->cachedTail) {
+				this->cachedTail = this->tail.load(std::memory_order_acquire);
+				if (h == this->cachedTail) {
+					return false;
+				}
+			}
+			value = this->buffer[h & MASK];
+			this->head.store(h + 1u, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Get the number of element in the queue, which may be outdated as soon as it returns
+		 * @return The number of element
+		*/
+		inline const size_t size() const {
+			return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Get the maximum number of element
+		 * @return The capacity
+		*/
+		inline static constexpr size_t capacity() {
+			return Capacity;
+		}
+
+	};
+}
+#endif//_SgTSPSCQueue_H_
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+#ifndef _SgTShaderBundle_H_
+#define _SgTShaderBundle_H_
+
+#include "SgTFileMapping.h"
+#include "SgTUtils.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A read-only archive of preprocessed shader sources, packed at build time by the SgTShaderPack tool.
+	 * The archive is memory mapped as a whole, and shaders are looked up by name with a binary search over the hash of the name,
+	 * so loading a shader neither touches the file system nor copies the source.
+	 * Layout: a header, the entry table sorted by name hash, the names, then the sources. All sources are null-terminated.
+	*/
+	class SgTShaderBundle {
+	public:
+
+		/**
+		 * @brief A shader in the bundle
+		*/
+		struct SgTBundleShader {
+		public:
+
+			//The source code, null-terminated
+			const char* data;
+			//The number of character in the source, without the null terminator
+			size_t length;
+			//The hash of the source, same as the hash computed by SgTShaderProc
+			SgTHash contentHash;
+
+		};
+
+		//The magic number at the beginning of every bundle, "SgTB"
+		static constexpr uint32_t MAGIC = 0x42546753u;
+		//Bump this when the layout changes
+		static constexpr uint32_t VERSION = 1u;
+
+	private:
+
+		/**
+		 * @brief The header of the archive
+		*/
+		struct SgTBundleHeader {
+		public:
+
+			uint32_t magic;
+			uint32_t version;
+			//The number of entry
+			uint32_t count;
+			uint32_t reserved;
+
+		};
+
+		/**
+		 * @brief An entry in the table, offsets are in byte from the beginning of the archive
+		*/
+		struct SgTBundleEntry {
+		public:
+
+			SgTHash nameHash;
+			SgTHash contentHash;
+			uint64_t nameOffset;
+			uint64_t nameLength;
+			uint64_t dataOffset;
+			uint64_t dataLength;
+
+		};
+
+		//The whole archive
+		SgTFileMapping mapping;
+		//The entry table inside the mapping, sorted by name hash
+		const SgTBundleEntry* entry = nullptr;
+		uint32_t count = 0u;
+
+	public:
+
+		/**
+		 * @brief Map a bundle.
+		 * Throw exception if the file cannot be mapped, or it is not a valid bundle of the current version
+		 * @param path The path of the bundle
+		*/
+		SgTShaderBundle(const SgTstring);
+
+		SgTShaderBundle(const SgTShaderBundle&) = delete;
+
+		SgTShaderBundle& operator=(const SgTShaderBundle&) = delete;
+
+		~SgTShaderBundle();
+
+		/**
+		 * @brief Write a bundle, shaders are stored as they are given.
+		 * Throw exception if the file cannot be written, or two shaders have the same name
+		 * @param path The path of the bundle
+		 * @param shader The name and the source code of each shader
+		*/
+		static void write(const SgTstring, const std::vector<std::pair<SgTstring, SgTstring>>&);
+
+		/**
+		 * @brief Find a shader by name
+		 * @param name The name of the shader given when the bundle is packed
+		 * @param shader The shader, only written if it is found
+		 * @return True if the shader is found
+		*/
+		const bool find(const SgTstring&, SgTBundleShader&) const;
+
+		/**
+		 * @brief Get a shader by name.
+		 * Throw exception if the shader is not in the bundle
+		 * @param name The name of the shader given when the bundle is packed
+		 * @return The shader, which is valid as long as the bundle is alive
+		*/
+		const SgTBundleShader getShader(const SgTstring&) const;
+
+		/**
+		 * @brief Get the number of shader in the bundle
+		 * @return The number of shader
+		*/
+		inline const unsigned int getShaderCount() const {
+			return this->count;
+		}
+
+	};
+}
+#endif//_SgTShaderBundle_H_
\ No newline at end of file
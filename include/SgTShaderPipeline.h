@@ -0,0 +1,89 @@
+#pragma once
+#ifndef _SgTShaderPipeline_H_
+#define _SgTShaderPipeline_H_
+
+#include "SgTShaderProc.h"
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A cache of program pipeline objects that combine separable programs at draw time.
+	 * Each stage is linked once as a separable program (see SgTShaderProc::useSeparable), and any combination of them is
+	 * a pipeline object, so N vertex and M fragment stages need N+M links instead of N*M.
+	 * A pipeline is created the first time a combination is requested and reused afterwards, swapping one stage only
+	 * looks up another pipeline and never relinks.
+	*/
+	class SgTShaderPipeline {
+	private:
+
+		/**
+		 * @brief A pipeline object and the programs it uses
+		*/
+		struct SgTPipelineEntry {
+		public:
+
+			GLuint pipeline;
+			//The program used by each stage, in the order of vertex, tess control, tess evaluation, geometry, fragment and compute
+			GLuint program[6];
+
+		};
+
+		//All pipelines, keyed by the hash of the programs of all stages
+		std::unordered_multimap<SgTHash, SgTPipelineEntry> pipeline;
+
+	public:
+
+		/**
+		 * @brief Initialise an empty pipeline cache
+		*/
+		SgTShaderPipeline();
+
+		SgTShaderPipeline(const SgTShaderPipeline&) = delete;
+
+		SgTShaderPipeline& operator=(const SgTShaderPipeline&) = delete;
+
+		/**
+		 * @brief Delete all pipelines
+		*/
+		~SgTShaderPipeline();
+
+		/**
+		 * @brief Get the pipeline that combines the separable programs, a new pipeline is created if the combination is new.
+		 * If more than one program contains the same stage, the later one is used for that stage.
+		 * @param program The linked separable programs
+		 * @param count The number of program
+		 * @return The pipeline object, ready to be bound by glBindProgramPipeline
+		*/
+		const GLuint getPipeline(const SgTShaderProc* const* const, const unsigned int);
+
+		/**
+		 * @brief Delete all pipelines using a program.
+		 * This must be called before the program is deleted or rebuilt, since a new program may reuse the same name.
+		 * @param program The separable program
+		*/
+		void removeProgram(const SgTShaderProc&);
+
+		/**
+		 * @brief Delete all pipelines using a program handle.
+		 * Use this for a program that has already been replaced, e.g. SgTShaderWatcher::SgTReloadResult::oldProgram
+		 * @param program The handle of the separable program
+		*/
+		void removeProgram(const GLuint);
+
+		/**
+		 * @brief Delete all pipelines
+		*/
+		void clear();
+
+		/**
+		 * @brief Get the number of pipelines in the cache
+		 * @return The number of pipeline
+		*/
+		const size_t getPipelineCount() const;
+
+	};
+}
+#endif//_SgTShaderPipeline_H_
\ No newline at end of file
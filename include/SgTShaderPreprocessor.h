@@ -0,0 +1,154 @@
+#pragma once
+#ifndef _SgTShaderPreprocessor_H_
+#define _SgTShaderPreprocessor_H_
+
+#include "SgTSourceCache.h"
+
+#include <vector>
+#include <unordered_set>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Resolve #include directives in shader sources before they are given to the driver.
+	 * Files that contain "#pragma once" or are wrapped by an include guard are only expanded once per shader.
+	 * Every expanded file is given a source string number, and "#line" directives are emitted such that the driver reports errors
+	 * as "number(line)", use getFileName() to find which file the number refers to.
+	 * The preprocessor also remembers which files each shader includes, so a change to a header only affects the shaders using it.
+	 * Note that conditional directives are left to the driver, an #include inside an inactive #if block is still expanded.
+	*/
+	class SgTShaderPreprocessor {
+	private:
+
+		//The maximum depth of nested include, to stop include cycles without guard
+		static constexpr int MAX_INCLUDE_DEPTH = 64;
+
+		//The source cache to read files from, or null to read files directly
+		SgTSourceCache* const Cache;
+		//Directories to search for included files, after the directory of the including file
+		std::vector<SgTstring> includePath;
+
+		//The file name of each source string number
+		std::vector<SgTstring> fileName;
+		//The source string number of each file
+		std::unordered_map<SgTstring, int> fileNumber;
+
+		//All files included by each shader, directly or indirectly
+		std::unordered_map<SgTstring, std::unordered_set<SgTstring>> dependency;
+		//All shaders including each file, directly or indirectly
+		std::unordered_map<SgTstring, std::unordered_set<SgTstring>> dependent;
+
+		/**
+		 * @brief The state of preprocessing one shader
+		*/
+		struct SgTExpansion {
+		public:
+
+			//The shader being preprocessed
+			SgTstring root;
+			//Files with "#pragma once" that have been expanded
+			std::unordered_set<SgTstring> onceFile;
+			//Include guard macros that have been defined
+			std::unordered_set<SgTstring> guard;
+			//The output
+			SgTstring code;
+
+		};
+
+		/**
+		 * @brief Get the source string number of a file, a new number is given if the file has not been seen
+		 * @param path The normalised path of the file
+		 * @return The source string number
+		*/
+		const int getFileNumber(const SgTstring&);
+
+		/**
+		 * @brief Read the whole content of a file
+		 * @param path The normalised path of the file
+		 * @return The content of the file
+		*/
+		const SgTstring readFile(const SgTstring&);
+
+		/**
+		 * @brief Find the file included by a #include directive.
+		 * Throw exception if the file cannot be found in any include path
+		 * @param name The name inside the quotes or angle brackets
+		 * @param includer The normalised path of the file containing the directive
+		 * @return The normalised path of the included file
+		*/
+		const SgTstring resolveInclude(const SgTstring&, const SgTstring&) const;
+
+		/**
+		 * @brief Expand a file and all its includes into the output
+		 * @param path The normalised path of the file
+		 * @param expansion The state of preprocessing
+		 * @param depth The current include depth
+		*/
+		void expandFile(const SgTstring&, SgTExpansion&, const int);
+
+	public:
+
+		/**
+		 * @brief Initialise the preprocessor
+		 * @param cache The source cache to read files from, or null to read files directly
+		*/
+		SgTShaderPreprocessor(SgTSourceCache* const = nullptr);
+
+		~SgTShaderPreprocessor();
+
+		/**
+		 * @brief Normalise a path such that the same file is always given the same path
+		 * @param path The path of a file
+		 * @return The normalised path
+		*/
+		static const SgTstring normalisePath(const SgTstring&);
+
+		/**
+		 * @brief Add a directory to search for included files
+		 * @param path The directory
+		*/
+		void addIncludePath(const SgTstring);
+
+		/**
+		 * @brief Read a shader and expand all #include directives, the dependency of the shader is recorded.
+		 * Throw exception if any file cannot be read or found, or the include is too deep
+		 * @param path The path of the shader
+		 * @return The preprocessed source code
+		*/
+		const SgTstring preprocess(const SgTstring);
+
+		/**
+		 * @brief Find all shaders that need to be preprocessed again when a file is changed
+		 * @param path The path of the changed file
+		 * @return The normalised path of all affected shaders, including the file itself if it is a shader
+		*/
+		const std::vector<SgTstring> getDependent(const SgTstring) const;
+
+		/**
+		 * @brief Get all files included by a shader, as of the last time it was preprocessed
+		 * @param shader The path of the shader
+		 * @return The normalised path of all included files, directly or indirectly
+		*/
+		const std::vector<SgTstring> getDependency(const SgTstring) const;
+
+		/**
+		 * @brief Check if a shader includes a file
+		 * @param shader The path of the shader
+		 * @param path The path of the file
+		 * @return True if the file is the shader itself, or it is included by the shader directly or indirectly
+		*/
+		const bool dependsOn(const SgTstring, const SgTstring) const;
+
+		/**
+		 * @brief Get the file referred by the source string number from a driver error log
+		 * @param number The source string number
+		 * @return The path of the file, or an empty string if the number is unknown
+		*/
+		const SgTstring getFileName(const int) const;
+
+	};
+}
+#endif//_SgTShaderPreprocessor_H_
\ No newline at end of file
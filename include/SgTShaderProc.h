@@ -3,6 +3,17 @@
 #define _SgTShaderProc_H_
 
 #include "SgTDefineFile.h"
+#include "SgTProgramCache.h"
+#include "SgTSourceCache.h"
+#include "SgTShaderPreprocessor.h"
+#include "SgTShaderRegistry.h"
+#include "SgTShaderReflection.h"
+#include "SgTShaderBundle.h"
+#include "SgTShaderProfiler.h"
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
 
 /**
  * @brief Simple OpenGL Toolkit
@@ -14,6 +25,104 @@ namespace SglToolkit {
 	It will throws out the error if compile has failed.
 	*/
 	class SgTShaderProc {
+	public:
+
+		/**
+		 * @brief A pollable handle of a program that is being compiled and linked asynchronously.
+		 * The handle must not outlive the shader processor that creates it.
+		*/
+		class SgTLinkFuture {
+		private:
+
+			//The shader processor that is linking
+			SgTShaderProc* Proc;
+			//The status, only valid when resolved
+			SgTShaderStatus status;
+			bool resolved;
+
+		public:
+
+			/**
+			 * @brief Initialise the future
+			 * @param proc The shader processor that is linking
+			 * @param status The status, if the link has already been resolved
+			 * @param resolved Set to true if the status is already known
+			*/
+			SgTLinkFuture(SgTShaderProc* const, const SgTShaderStatus, const bool);
+
+			~SgTLinkFuture();
+
+			/**
+			 * @brief Check if the compilation and linkage has finished without blocking.
+			 * If GL_KHR_parallel_shader_compile is not supported, it always returns true and get() may block.
+			 * @return True if get() can be called without stalling
+			*/
+			const bool isReady() const;
+
+			/**
+			 * @brief Get the status of compilation and linkage, it blocks if the program is not ready.
+			 * The status is only evaluated once, calling this function again returns the same status without the log.
+			 * @param log The error log if error occurs
+			 * @param bufferSize The size of the buffer that is allocated for the log
+			 * @return The status of compilation and linkage
+			*/
+			const SgTShaderStatus get(GLchar*, const int);
+
+		};
+
+		/**
+		 * @brief The entry point and specialization constants of a SPIR-V shader.
+		 * Every constant is given as a 32-bit value, floating point constants are passed by their bit pattern.
+		*/
+		struct SgTSpecialization {
+		public:
+
+			//The name of the entry point in the module
+			SgTstring entryPoint;
+			//The constant ID and the value of each specialization constant, sorted by ID
+			std::vector<GLuint> index;
+			std::vector<GLuint> value;
+
+			/**
+			 * @brief Initialise a specialization with entry point "main" and no constant
+			*/
+			SgTSpecialization() : entryPoint("main") {
+
+			}
+
+			/**
+			 * @brief Set a specialization constant, the last value is used if the same constant is set twice.
+			 * Constants are kept sorted by ID, so the order they are set in does not matter
+			 * @param id The constant ID, as given by layout(constant_id = id)
+			 * @param value The value
+			*/
+			inline void setConstant(const GLuint id, const GLuint value) {
+				const auto it = std::lower_bound(this->index.begin(), this->index.end(), id);
+				const auto position = it - this->index.begin();
+				if (it != this->index.end() && *it == id) {
+					this->value[position] = value;
+					return;
+				}
+				this->index.insert(it, id);
+				this->value.insert(this->value.begin() + position, value);
+			}
+
+			inline void setConstant(const GLuint id, const GLint value) {
+				this->setConstant(id, static_cast<GLuint>(value));
+			}
+
+			inline void setConstant(const GLuint id, const GLfloat value) {
+				GLuint bit;
+				std::memcpy(&bit, &value, sizeof(bit));
+				this->setConstant(id, bit);
+			}
+
+			inline void setConstant(const GLuint id, const bool value) {
+				this->setConstant(id, static_cast<GLuint>(value ? GL_TRUE : GL_FALSE));
+			}
+
+		};
+
 	private:
 
 		/*
@@ -25,6 +134,128 @@ namespace SglToolkit {
 		 * @brief Check if the shader is used
 		*/
 		bool shaderused[6] = { false, false, false, false, false, false };
+		/**
+		 * @brief The hash of the source code of each shader
+		*/
+		SgTHash shaderHash[6] = { 0ull, 0ull, 0ull, 0ull, 0ull, 0ull };
+		/**
+		 * @brief Check if the shader has been compiled, such that it will not be compiled again when the program is relinked
+		*/
+		bool shaderCompiled[6] = { false, false, false, false, false, false };
+
+		/**
+		 * @brief Where the source code of a shader comes from, so the shader can be loaded again when the file is changed
+		*/
+		struct SgTShaderSource {
+		public:
+
+			//The normalised path of the shader
+			SgTstring path;
+			//The source cache that the file is read from, or null
+			SgTSourceCache* cache = nullptr;
+			//The preprocessor that expands the file, or null
+			SgTShaderPreprocessor* preprocessor = nullptr;
+			//Set to true if the file is a SPIR-V module rather than GLSL source
+			bool binary = false;
+			//How the SPIR-V module is specialized, only used if it is binary
+			SgTSpecialization specialization;
+
+		};
+		SgTShaderSource shaderSource[6];
+
+		//Set to true if shaders are taken from the shader registry
+		bool shareShader = false;
+		//Set to true if the program is linked as a separable program
+		bool separable = false;
+
+		//The program binary cache, or null if program is always compiled from source
+		SgTProgramCache* programCache = nullptr;
+		//Describe the pre-link settings of the program, as part of the program key
+		SgTstring programTag;
+
+		/**
+		 * @brief Get the index of the shader handle for the shader type.
+		 * Throw exception If the GLenum is invalid
+		 * @param type The type of shader
+		 * @return The index of the shader handle, starting from 1
+		*/
+		static const int getHandleIndex(const GLenum);
+
+		/**
+		 * @brief Mark a shader as used and get a handle for it, the handle may be taken from the shader registry
+		 * @param type The type of shader
+		 * @param hash The hash of the content of the shader
+		 * @return True if the shader is new and its content must be set, false if it is shared and already set
+		*/
+		const bool allocateShader(const GLenum, const SgTHash);
+
+		/**
+		 * @brief Create a new shader from a SPIR-V module and specialize it, shader does not need to be compiled
+		 * @param type The type of shader
+		 * @param binary The SPIR-V module
+		 * @param length The number of byte in the module
+		 * @param specialization The entry point and specialization constants
+		*/
+		void createShaderBinary(const GLenum, const char* const, const size_t, const SgTSpecialization&);
+
+		/**
+		 * @brief Create a new shader and set the source code, shader is not compiled
+		 * @param type The type of shader
+		 * @param code The source strings, do not need to be null-terminated
+		 * @param length The number of character in each source string
+		 * @param count The number of source string
+		 * @param hash The precomputed hash of all source strings, or null to hash the strings
+		*/
+		void createShader(const GLenum, const char* const* const, const GLint* const, const GLsizei, const SgTHash* const = nullptr);
+
+		/**
+		 * @brief Delete a shader, or drop the reference if the shader is shared
+		 * @param handle The shader
+		*/
+		static void destroyShader(const GLuint);
+
+		/**
+		 * @brief Read the source code and create a new shader, shader is not compiled
+		 * @param type The type of shader
+		 * @param source Where the source code comes from
+		*/
+		void loadShader(const GLenum, const SgTShaderSource&);
+
+		//The active resources of the linked program
+		SgTShaderReflection reflection;
+
+		//The key of the program that is being linked, for storing the program binary
+		SgTHash programKey = 0ull;
+
+		//The identity of the program in the profiler, the name defaults to the first shader file
+		SgTShaderProfiler::SgTProgramLabel programLabel;
+
+		/**
+		 * @brief Check if the driver can compile shaders in background threads
+		 * @return True if GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile is supported
+		*/
+		static const bool hasParallelCompile();
+
+		/**
+		 * @brief Issue compile and link commands for all shaders without querying any status
+		 * @param arg The argument for the program before the program is linked
+		 * @return True if the program has been loaded from the program cache and no command is issued
+		*/
+		const bool beginLink(SgTProgramPara);
+
+		/**
+		 * @brief Query the status of all shaders and the program issued by beginLink, this may stall until the driver has finished
+		 * @param log The error log if error occurs
+		 * @param bufferSize The size of the buffer that is allocated for the log
+		 * @return The status of compilation and linkage
+		*/
+		const SgTShaderStatus endLink(GLchar*, const int);
+
+		/**
+		 * @brief Calculate the key that identifies the program in the program cache
+		 * @return The program key
+		*/
+		const SgTHash calcProgramKey();
 
 		/*
 		Check if the GLSL compiler throws any errors
@@ -68,6 +299,87 @@ namespace SglToolkit {
 		*/
 		void addShader(const GLenum, const SgTstring);
 
+		/**
+		 * @brief Import the shader code through a source cache and add to a new shader, shader is not compiled.
+		 * The mapped file is given to the driver without being copied, and it is shared with every other shader reading the same file.
+		 * Throw exception If the GLenum is invalid, or the file cannot be opened
+		 * @param type The type of shader
+		 * @param path The path where the shader code is stored
+		 * @param cache The source cache where the file is mapped
+		*/
+		void addShader(const GLenum, const SgTstring, SgTSourceCache&);
+
+		/**
+		 * @brief Import the shader code through a preprocessor that resolves all #include and add to a new shader, shader is not compiled.
+		 * Throw exception If the GLenum is invalid, or any file cannot be read
+		 * @param type The type of shader
+		 * @param path The path where the shader code is stored
+		 * @param preprocessor The preprocessor, it must outlive this shader processor
+		*/
+		void addShader(const GLenum, const SgTstring, SgTShaderPreprocessor&);
+
+		/**
+		 * @brief Import the shader code from a shader bundle and add to a new shader, shader is not compiled.
+		 * The source is given to the driver from the mapped bundle without being copied, and the hash stored in the bundle is used.
+		 * Shader added this way cannot be rebuilt.
+		 * Throw exception If the GLenum is invalid, or the shader is not in the bundle
+		 * @param type The type of shader
+		 * @param name The name of the shader in the bundle
+		 * @param bundle The shader bundle
+		*/
+		void addShader(const GLenum, const SgTstring, const SgTShaderBundle&);
+
+		/**
+		 * @brief Import a SPIR-V module and add to a new shader, the module is specialized immediately so the GLSL compiler is never invoked.
+		 * Errors of specialization are reported by linkShader() with the error code of the shader type, same as GLSL shaders.
+		 * Throw exception If the GLenum is invalid, the file cannot be opened, or SPIR-V is not supported by the driver
+		 * @param type The type of shader
+		 * @param path The path of the SPIR-V module
+		 * @param specialization The entry point and specialization constants
+		*/
+		void addShaderBinary(const GLenum, const SgTstring, const SgTSpecialization& = SgTSpecialization());
+
+		/**
+		 * @brief Import a SPIR-V module through a source cache and add to a new shader, the module is specialized immediately.
+		 * The mapped module is shared with every other shader reading the same file, so variants only differ by their specialization constants.
+		 * Throw exception If the GLenum is invalid, the file cannot be opened, or SPIR-V is not supported by the driver
+		 * @param type The type of shader
+		 * @param path The path of the SPIR-V module
+		 * @param cache The source cache where the file is mapped
+		 * @param specialization The entry point and specialization constants
+		*/
+		void addShaderBinary(const GLenum, const SgTstring, SgTSourceCache&, const SgTSpecialization& = SgTSpecialization());
+
+		/**
+		 * @brief Check if the driver accepts SPIR-V shaders, either OpenGL 4.6 or GL_ARB_gl_spirv
+		 * @return True if SPIR-V is supported
+		*/
+		static const bool hasSPIRV();
+
+		/**
+		 * @brief Add a new shader from source strings in memory, shader is not compiled.
+		 * The strings are concatenated by the driver in order, no copy is made. Shader added this way cannot be rebuilt.
+		 * Throw exception If the GLenum is invalid
+		 * @param type The type of shader
+		 * @param code The source strings, do not need to be null-terminated
+		 * @param length The number of character in each source string
+		 * @param count The number of source string
+		*/
+		void addShaderSource(const GLenum, const char* const* const, const GLint* const, const GLsizei);
+
+		/**
+		 * @brief Reload and recompile only the shaders whose source or included files have changed, and relink the program.
+		 * The current program stays valid until the new program is linked successfully, after which it is deleted and getP()
+		 * returns the new program. If anything fails, the new program is discarded and the current program is kept.
+		 * Throw exception if any file cannot be read, the current program is also kept.
+		 * @param changed The path of all changed files
+		 * @param log The error log if error occurs
+		 * @param bufferSize The size of the buffer that is allocated for the log
+		 * @param arg The argument for the program before the program is linked, supplied with a callback function
+		 * @return The status of compilation and linkage, or OK if no shader is affected
+		*/
+		SgTShaderStatus rebuildShader(const std::vector<SgTstring>&, GLchar*, const int, SgTProgramPara = NULL);
+
 		/**
 		 * @brief Compile all shaders that have been set and link to the programe
 		 * @param GLchar log - The error log if error occurs
@@ -77,6 +389,70 @@ namespace SglToolkit {
 		*/
 		SgTShaderStatus linkShader(GLchar*, const int, SgTProgramPara = NULL);
 
+		/**
+		 * @brief Issue compilation and linkage of all shaders without waiting for the result.
+		 * To build many programs in parallel, call this function on every shader processor first and then poll the futures,
+		 * the driver compiles in background threads if GL_KHR_parallel_shader_compile is supported.
+		 * @param arg The argument for the program before the program is linked, supplied with a callback function
+		 * @return A future of the status of compilation and linkage
+		*/
+		SgTLinkFuture linkShaderAsync(SgTProgramPara = NULL);
+
+		/**
+		 * @brief Use a program binary cache for the following linkShader calls.
+		 * When the program is found in the cache, compilation, linkage and the program parameter callback are all skipped.
+		 * @param cache The program cache, or null to disable caching
+		 * @param tag A string that describes everything the program parameter callback sets, e.g. "feedback:outPos".
+		 * The callback itself cannot be inspected so programs with different callbacks must be given different tags.
+		*/
+		void useProgramCache(SgTProgramCache* const, const SgTstring = "");
+
+		/**
+		 * @brief Share shaders with all other shader processors through the shader registry, for the following addShader calls.
+		 * A shader with the same type and source code is then compiled only once in the process, regardless of how many programs use it.
+		 * Shared shaders must not be modified, and deleteShader only drops the reference.
+		 * @param share True to share shaders
+		*/
+		void useShaderRegistry(const bool);
+
+		/**
+		 * @brief Link the program as a separable program (GL_PROGRAM_SEPARABLE) for the following linkShader calls.
+		 * Separable programs usually contain one stage and are combined at draw time with a program pipeline, see SgTShaderPipeline.
+		 * @param separable True to link as separable program
+		*/
+		void useSeparable(const bool);
+
+		/**
+		 * @brief Get the active resources of the program, it is updated every time the program is linked successfully
+		 * @return The reflection of the program
+		*/
+		const SgTShaderReflection& getReflection() const;
+
+		/**
+		 * @brief Set the name of the program, which is shown with the time of the program by SgTShaderProfiler.
+		 * The profiler tells shader processors apart by a serial number, so the name does not need to be unique
+		 * @param name The name of the program
+		*/
+		void setName(const SgTstring);
+
+		/**
+		 * @brief Get the name of the program
+		 * @return The name set by setName(), or the first shader file added if it is not set
+		*/
+		const SgTstring& getName() const;
+
+		/**
+		 * @brief Get the stages contained in the program
+		 * @return The bitwise OR of GL_*_SHADER_BIT of every shader that has been added
+		*/
+		const GLbitfield getStageBit() const;
+
+		/**
+		 * @brief Get all files that the shaders are loaded from, including files pulled in by #include
+		 * @return The normalised path of all source files
+		*/
+		const std::vector<SgTstring> getSourceFile() const;
+
 		/**
 		 * @brief Delete the current program and all linked shader, after which the ShaderProc will be reset and can be reused
 		*/
@@ -0,0 +1,230 @@
+#pragma once
+#ifndef _SgTShaderProfiler_H_
+#define _SgTShaderProfiler_H_
+
+#include "SgTDefineFile.h"
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A process-wide recorder of the time spent on loading, compiling and linking shaders.
+	 * Profiling is disabled by default, a disabled scope costs a single atomic load.
+	 * Every event is attributed to the shader processor it belongs to, by the serial number of its program label,
+	 * and the name of the label (see SgTShaderProc::setName()) is only shown with it, so programs sharing a name are timed separately.
+	 * Events without a program inherit the program of the enclosing scope on the same thread.
+	 * Note that with GL_KHR_parallel_shader_compile, compile and link calls only issue the work,
+	 * and the time is spent when the status is queried, which is recorded as WAIT.
+	*/
+	struct SgTShaderProfiler {
+	public:
+
+		//Categories of event
+		static constexpr const char* LOAD = "load";
+		static constexpr const char* IO = "io";
+		static constexpr const char* COMPILE = "compile";
+		static constexpr const char* LINK = "link";
+		static constexpr const char* WAIT = "wait";
+
+		/**
+		 * @brief A timed event
+		*/
+		struct SgTEvent {
+		public:
+
+			//What is timed, e.g. "readCode"
+			const char* name;
+			//One of the categories
+			const char* category;
+			//The file involved, may be empty
+			SgTstring detail;
+			//The serial number of the program the event belongs to, 0 if there is none
+			unsigned long long serial;
+			//The name of the program, may be empty
+			SgTstring program;
+			//Nanosecond since the profiler is first used
+			long long begin;
+			long long duration;
+			//The thread that records the event
+			size_t thread;
+
+		};
+
+		/**
+		 * @brief The total time of a program, in nanosecond
+		*/
+		struct SgTProgramTime {
+		public:
+
+			//The serial number of the program, 0 for events outside any program
+			unsigned long long serial;
+			//The name of the program when it was last recorded
+			SgTstring program;
+			//Reading and preprocessing files, as part of load
+			long long io;
+			//Creating shaders, including io
+			long long load;
+			long long compile;
+			long long link;
+			//Waiting for the driver when the status is queried
+			long long wait;
+			//load + compile + link + wait
+			long long total;
+
+		};
+
+		/**
+		 * @brief The identity of a program in the profiler.
+		 * Every label has its own serial number, a copied label is given a new one so it is never mixed up with the original
+		*/
+		class SgTProgramLabel {
+		private:
+
+			unsigned long long serial;
+
+		public:
+
+			//The name shown with the program
+			SgTstring name;
+
+			/**
+			 * @brief Create a label with a new serial number and an empty name
+			*/
+			SgTProgramLabel();
+
+			/**
+			 * @brief Copy the name, and create a new serial number
+			 * @param label The label to be copied
+			*/
+			SgTProgramLabel(const SgTProgramLabel&);
+
+			/**
+			 * @brief Copy the name, the serial number is kept
+			 * @param label The label to be copied
+			*/
+			SgTProgramLabel& operator=(const SgTProgramLabel&);
+
+			/**
+			 * @brief Get the serial number
+			 * @return The serial number, never 0
+			*/
+			inline const unsigned long long getSerial() const {
+				return this->serial;
+			}
+
+		};
+
+		/**
+		 * @brief Time a scope and record it as an event when the scope ends
+		*/
+		class SgTScope {
+		private:
+
+			bool active;
+			const char* name;
+			const char* category;
+			SgTstring detail;
+			//The program of the enclosing scope, restored when the scope ends
+			const SgTProgramLabel* parentProgram;
+			std::chrono::steady_clock::time_point begin;
+
+		public:
+
+			/**
+			 * @brief Start timing if the profiler is enabled
+			 * @param category The category of the event
+			 * @param name What is timed, must be a string literal
+			 * @param detail The file involved
+			 * @param program The program of this scope and every nested scope, or null to inherit the enclosing program.
+			 * The label must outlive the scope
+			*/
+			SgTScope(const char* const, const char* const, const SgTstring& = SgTstring(), const SgTProgramLabel* const = nullptr);
+
+			SgTScope(const SgTScope&) = delete;
+
+			SgTScope& operator=(const SgTScope&) = delete;
+
+			~SgTScope();
+
+		};
+
+	private:
+
+		static std::atomic<bool> enabled;
+		static std::mutex eventLock;
+		static std::vector<SgTEvent> event;
+		//The time all events are relative to
+		static const std::chrono::steady_clock::time_point epoch;
+		//The last serial number given to a program label
+		static std::atomic<unsigned long long> serialCount;
+
+		/**
+		 * @brief This is a full-static struct and should not be instanciated
+		*/
+		SgTShaderProfiler() {
+
+		}
+
+		~SgTShaderProfiler() {
+
+		}
+
+	public:
+
+		/**
+		 * @brief Start or stop recording, recorded events are kept
+		 * @param enable True to start recording
+		*/
+		static void enable(const bool);
+
+		/**
+		 * @brief Check if the profiler is recording
+		 * @return True if recording
+		*/
+		inline static const bool isEnabled() {
+			return SgTShaderProfiler::enabled.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Discard all recorded events
+		*/
+		static void clear();
+
+		/**
+		 * @brief Get a copy of all recorded events, in the order they end
+		 * @return All events
+		*/
+		static const std::vector<SgTEvent> getEvent();
+
+		/**
+		 * @brief Sum the time of each program and sort them from the slowest, programs are told apart by the serial number
+		 * @param count The maximum number of program to be returned
+		 * @return The slowest programs
+		*/
+		static const std::vector<SgTProgramTime> getSlowest(const size_t);
+
+		/**
+		 * @brief Write all recorded events as a Chrome trace, which can be opened by chrome://tracing or Perfetto.
+		 * Throw exception if the file cannot be written
+		 * @param path The path of the JSON file
+		*/
+		static void writeTrace(const SgTstring);
+
+		/**
+		 * @brief Write a table of the slowest programs in millisecond
+		 * @param output The stream to be written
+		 * @param count The maximum number of program
+		*/
+		static void writeSummary(std::ostream&, const size_t);
+
+	};
+}
+#endif//_SgTShaderProfiler_H_
\ No newline at end of file
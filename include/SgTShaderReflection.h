@@ -0,0 +1,221 @@
+#pragma once
+#ifndef _SgTShaderReflection_H_
+#define _SgTShaderReflection_H_
+
+#include "SgTUtils.h"
+
+#include <vector>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Reflection of the active resources of a linked program.
+	 * All resources are queried once and stored in tables sorted by the hash of the name, such that lookups never touch the driver
+	 * or compare strings. Names can be hashed at compile time with SgTShaderReflection::nameID or the _SgTID literal.
+	 * Array names are stored without the trailing "[0]", so "light" finds "light[0]".
+	*/
+	class SgTShaderReflection {
+	public:
+
+		/**
+		 * @brief A uniform in the default block or in a uniform block
+		*/
+		struct SgTUniformInfo {
+		public:
+
+			SgTHash name;
+			//The location, -1 if the uniform is inside a uniform block
+			GLint location;
+			GLenum type;
+			//The number of element, 1 if the uniform is not an array
+			GLint arraySize;
+			//The index of the uniform block, -1 if it is in the default block
+			GLint blockIndex;
+			//The std140 byte offset, array stride and matrix stride inside the block, -1 if it is in the default block
+			GLint offset, arrayStride, matrixStride;
+
+		};
+
+		/**
+		 * @brief A uniform block or shader storage block
+		*/
+		struct SgTBlockInfo {
+		public:
+
+			SgTHash name;
+			//The index of the block in the program
+			GLuint index;
+			//The binding point
+			GLint binding;
+			//The minimum size of the buffer backing the block
+			GLint dataSize;
+
+		};
+
+		/**
+		 * @brief A member of a shader storage block
+		*/
+		struct SgTBufferVariableInfo {
+		public:
+
+			SgTHash name;
+			GLenum type;
+			GLint arraySize;
+			//The index of the shader storage block
+			GLint blockIndex;
+			//The std430 byte offset, array stride, matrix stride and the stride of the top level array
+			GLint offset, arrayStride, matrixStride, topLevelArrayStride;
+
+		};
+
+	private:
+
+		//All tables are sorted by name
+		std::vector<SgTUniformInfo> uniform;
+		std::vector<SgTBlockInfo> uniformBlock;
+		std::vector<SgTBlockInfo> storageBlock;
+		std::vector<SgTBufferVariableInfo> bufferVariable;
+		//The local size of the compute shader, 0 if there is no compute shader
+		GLint workGroupSize[3] = { 0, 0, 0 };
+
+		/**
+		 * @brief Find an entry in a table by its name
+		 * @param table The table sorted by name
+		 * @param name The hash of the name
+		 * @return The entry, or null if not found
+		*/
+		template<class Info>
+		static const Info* const find(const std::vector<Info>&, const SgTHash);
+
+		/**
+		 * @brief Get the name of a resource, without the trailing "[0]" of array
+		 * @param program The program
+		 * @param programInterface The interface of the resource
+		 * @param index The index of the resource
+		 * @param buffer The buffer to hold the name
+		 * @return The hash of the name
+		*/
+		static const SgTHash getResourceName(const GLuint, const GLenum, const GLuint, std::vector<GLchar>&);
+
+		/**
+		 * @brief Query all blocks of an interface
+		 * @param program The program
+		 * @param programInterface GL_UNIFORM_BLOCK or GL_SHADER_STORAGE_BLOCK
+		 * @param table The table to be filled
+		*/
+		static void reflectBlock(const GLuint, const GLenum, std::vector<SgTBlockInfo>&);
+
+	public:
+
+		/**
+		 * @brief Initialise an empty reflection
+		*/
+		SgTShaderReflection();
+
+		~SgTShaderReflection();
+
+		/**
+		 * @brief Hash a resource name at compile time
+		 * @param name The name of the resource
+		 * @return The name ID to be used in lookups
+		*/
+		constexpr static SgTHash nameID(const char* const name) {
+			return SgTUtils::hashFNV(name);
+		}
+
+		/**
+		 * @brief Query all active resources of a linked program, previous reflection is discarded
+		 * @param program The linked program
+		 * @param compute True if the program contains a compute shader, so the work group size is queried
+		*/
+		void reflect(const GLuint, const bool);
+
+		/**
+		 * @brief Discard all reflection
+		*/
+		void clear();
+
+		/**
+		 * @brief Get the location of a uniform in the default block
+		 * @param name The name ID of the uniform
+		 * @return The location, or -1 if the uniform is not active or inside a uniform block
+		*/
+		inline const GLint getUniformLocation(const SgTHash name) const {
+			const SgTUniformInfo* const info = SgTShaderReflection::find(this->uniform, name);
+			return info == nullptr ? -1 : info->location;
+		}
+
+		/**
+		 * @brief Get a uniform
+		 * @param name The name ID of the uniform
+		 * @return The uniform, or null if it is not active
+		*/
+		inline const SgTUniformInfo* const getUniform(const SgTHash name) const {
+			return SgTShaderReflection::find(this->uniform, name);
+		}
+
+		/**
+		 * @brief Get a uniform block
+		 * @param name The name ID of the block
+		 * @return The uniform block, or null if it is not active
+		*/
+		inline const SgTBlockInfo* const getUniformBlock(const SgTHash name) const {
+			return SgTShaderReflection::find(this->uniformBlock, name);
+		}
+
+		/**
+		 * @brief Get a shader storage block
+		 * @param name The name ID of the block
+		 * @return The shader storage block, or null if it is not active
+		*/
+		inline const SgTBlockInfo* const getStorageBlock(const SgTHash name) const {
+			return SgTShaderReflection::find(this->storageBlock, name);
+		}
+
+		/**
+		 * @brief Get a member of a shader storage block
+		 * @param name The name ID of the member, e.g. "Particle.position" for a block member without instance name
+		 * @return The buffer variable, or null if it is not active
+		*/
+		inline const SgTBufferVariableInfo* const getBufferVariable(const SgTHash name) const {
+			return SgTShaderReflection::find(this->bufferVariable, name);
+		}
+
+		/**
+		 * @brief Get the local work group size of the compute shader
+		 * @return The pointer to the size in x, y and z, all 0 if there is no compute shader
+		*/
+		inline const GLint* const getWorkGroupSize() const {
+			return this->workGroupSize;
+		}
+
+	};
+
+	/**
+	 * @brief Hash a resource name at compile time, e.g. "modelMat"_SgTID
+	*/
+	constexpr SgTHash operator""_SgTID(const char* const name, const size_t length) {
+		return SgTUtils::hashFNV(name, length);
+	}
+
+	template<class Info>
+	const Info* const SgTShaderReflection::find(const std::vector<Info>& table, const SgTHash name) {
+		//binary search, tables are small and contiguous
+		size_t first = 0, count = table.size();
+		while (count > 0) {
+			const size_t half = count / 2;
+			if (table[first + half].name < name) {
+				first += half + 1;
+				count -= half + 1;
+			}
+			else {
+				count = half;
+			}
+		}
+		return first < table.size() && table[first].name == name ? &table[first] : nullptr;
+	}
+}
+#endif//_SgTShaderReflection_H_
\ No newline at end of file
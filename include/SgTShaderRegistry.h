@@ -0,0 +1,87 @@
+#pragma once
+#ifndef _SgTShaderRegistry_H_
+#define _SgTShaderRegistry_H_
+
+#include "SgTDefineFile.h"
+
+#include <unordered_map>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A process-wide registry of reference counted shader objects.
+	 * Shaders with the same type and source code are created and compiled only once, and shared by every program using it.
+	 * The registry assumes all programs live in the same OpenGL context (or share group), and it must only be used from the
+	 * thread that holds the context.
+	*/
+	struct SgTShaderRegistry {
+	private:
+
+		/**
+		 * @brief A shared shader object
+		*/
+		struct SgTSharedShader {
+		public:
+
+			GLuint handle;
+			//The number of shader processors using it
+			unsigned int reference;
+			//Set to true once the shader is compiled by anyone
+			bool compiled;
+
+		};
+
+		//All shared shaders, keyed by the hash of type and source
+		static std::unordered_map<SgTHash, SgTSharedShader> shader;
+		//The key of each shared shader object
+		static std::unordered_map<GLuint, SgTHash> shaderKey;
+
+		/**
+		 * @brief This is a full-static struct and should not be instanciated
+		*/
+		SgTShaderRegistry() {
+
+		}
+
+		~SgTShaderRegistry() {
+
+		}
+
+	public:
+
+		/**
+		 * @brief Get a shader object for the type and source, the reference count is increased.
+		 * If no shader has the same source, a new shader is created, and the source needs to be set by the caller
+		 * @param type The type of shader
+		 * @param hash The hash of the source code, after preprocessing
+		 * @param created Set to true if a new shader is created
+		 * @return The shader object
+		*/
+		static const GLuint acquire(const GLenum, const SgTHash, bool&);
+
+		/**
+		 * @brief Decrease the reference count of a shader object, the shader is deleted when no one is using it
+		 * @param handle The shader object
+		 * @return False if the shader is not managed by the registry, and nothing is done
+		*/
+		static const bool release(const GLuint);
+
+		/**
+		 * @brief Compile a shared shader if it has not been compiled by anyone
+		 * @param handle The shader object
+		 * @return False if the shader is not managed by the registry, and nothing is done
+		*/
+		static const bool compile(const GLuint);
+
+		/**
+		 * @brief Get the number of distinct shader objects that are alive
+		 * @return The number of shared shaders
+		*/
+		static const size_t getShaderCount();
+
+	};
+}
+#endif//_SgTShaderRegistry_H_
\ No newline at end of file
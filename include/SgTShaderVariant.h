@@ -0,0 +1,150 @@
+#pragma once
+#ifndef _SgTShaderVariant_H_
+#define _SgTShaderVariant_H_
+
+#include "SgTShaderProc.h"
+
+#include <memory>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Compile permutations of the same shaders with different feature keywords.
+	 * Each keyword is a bit in the feature mask, and a variant is built by injecting "#define KEYWORD" for every bit that is set,
+	 * right after the #version directive. Keywords not referenced by a shader are not injected into that shader, and all
+	 * shaders are shared through SgTShaderRegistry, so a shader that does not depend on any enabled keyword is compiled once for all variants.
+	 * Variants are stored in a flat table indexed by the feature mask, looking up a variant is a single array access.
+	*/
+	class SgTShaderVariant {
+	public:
+
+		//The maximum number of keyword, the table has 2^keyword entries
+		static constexpr unsigned int MAX_KEYWORD = 16u;
+
+	private:
+
+		/**
+		 * @brief The base source code of a shader
+		*/
+		struct SgTVariantSource {
+		public:
+
+			GLenum type;
+			//The base source code
+			SgTstring code;
+			//The position in the code right after the #version line, 0 if there is no #version
+			size_t versionEnd;
+			//The line number of the line after #version, for #line directive
+			SgTstring nextLine;
+			//Keyword bits referenced by the source
+			unsigned int keywordMask;
+
+		};
+		std::vector<SgTVariantSource> source;
+
+		//The feature keywords, and the define directive of each keyword
+		const std::vector<SgTstring> Keyword;
+		std::vector<SgTstring> defineLine;
+		//The argument for every variant before the program is linked
+		const SgTProgramPara Arg;
+		//The first shader file added, each variant is named after it with its feature mask, e.g. "shader.vert#5"
+		SgTstring baseName;
+
+		//All variants, indexed by the feature mask
+		std::vector<std::unique_ptr<SgTShaderProc>> variant;
+
+		/**
+		 * @brief Add all shaders with keywords of the feature mask to a shader processor
+		 * @param proc The shader processor
+		 * @param mask The feature mask
+		*/
+		void addVariantShader(SgTShaderProc&, const unsigned int);
+
+		/**
+		 * @brief Record the base source code of a shader
+		 * @param type The type of shader
+		 * @param code The base source code
+		*/
+		void addSource(const GLenum, const SgTstring&);
+
+	public:
+
+		//The number of program being compiled in parallel in a batch
+		unsigned int BATCH_SIZE = 64u;
+
+		/**
+		 * @brief Initialise the variant table.
+		 * Throw exception if there are more than MAX_KEYWORD keywords
+		 * @param keyword The feature keywords, the i-th keyword is enabled by the i-th bit of the feature mask
+		 * @param arg The argument for every variant before the program is linked, supplied with a callback function
+		*/
+		SgTShaderVariant(const std::vector<SgTstring>&, SgTProgramPara = NULL);
+
+		~SgTShaderVariant();
+
+		/**
+		 * @brief Import the base source code of a shader.
+		 * This must be done before any variant is built, throw exception If the GLenum is invalid or any variant has been built
+		 * @param type The type of shader
+		 * @param path The path where the shader code is stored
+		*/
+		void addShader(const GLenum, const SgTstring);
+
+		/**
+		 * @brief Import the base source code of a shader through a preprocessor.
+		 * This must be done before any variant is built, throw exception If the GLenum is invalid or any variant has been built
+		 * @param type The type of shader
+		 * @param path The path where the shader code is stored
+		 * @param preprocessor The preprocessor
+		*/
+		void addShader(const GLenum, const SgTstring, SgTShaderPreprocessor&);
+
+		/**
+		 * @brief Build variants in parallel batches, variants that have been built are skipped
+		 * @param mask The feature masks of variants to be built
+		 * @param count The number of feature mask
+		 * @param log The error log if error occurs
+		 * @param bufferSize The size of the buffer that is allocated for the log
+		 * @return The status of the first failed variant, or OK if all succeed. Failed variants are not stored
+		*/
+		SgTShaderStatus build(const unsigned int* const, const unsigned int, GLchar*, const int);
+
+		/**
+		 * @brief Build every permutation of keywords in parallel batches
+		 * @param log The error log if error occurs
+		 * @param bufferSize The size of the buffer that is allocated for the log
+		 * @return The status of the first failed variant, or OK if all succeed
+		*/
+		SgTShaderStatus buildAll(GLchar*, const int);
+
+		/**
+		 * @brief Get a variant, build it if it has not been built
+		 * @param mask The feature mask
+		 * @param log The error log if error occurs
+		 * @param bufferSize The size of the buffer that is allocated for the log
+		 * @return The variant, or null if it fails to build
+		*/
+		SgTShaderProc* const require(const unsigned int, GLchar*, const int);
+
+		/**
+		 * @brief Get the feature bit of a keyword, this is meant to be done once at setup and not per frame
+		 * @param keyword The keyword
+		 * @return The bit of the keyword, or 0 if the keyword is unknown
+		*/
+		const unsigned int getKeywordBit(const SgTstring&) const;
+
+		/**
+		 * @brief Get a variant that has been built
+		 * @param mask The feature mask, must be less than 2^keyword
+		 * @return The variant, or null if it has not been built
+		*/
+		inline SgTShaderProc* const get(const unsigned int mask) const {
+			return this->variant[mask].get();
+		}
+
+	};
+}
+#endif//_SgTShaderVariant_H_
\ No newline at end of file
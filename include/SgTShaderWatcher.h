@@ -0,0 +1,158 @@
+#pragma once
+#ifndef _SgTShaderWatcher_H_
+#define _SgTShaderWatcher_H_
+
+#include "SgTShaderProc.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Watch the source files of shader processors and rebuild the programs when any file is modified.
+	 * A background thread listens to file system events (inotify on Linux, modification time polling elsewhere) and queues them,
+	 * the programs are only rebuilt when process() is called from the thread that holds the OpenGL context.
+	 * Events of the same file are coalesced until the file has been quiet for a while, so an editor saving a file several times
+	 * only triggers one compilation.
+	*/
+	class SgTShaderWatcher {
+	public:
+
+		/**
+		 * @brief The result of rebuilding a program
+		*/
+		struct SgTReloadResult {
+		public:
+
+			//The shader processor being rebuilt
+			SgTShaderProc* proc;
+			//The program before the rebuild, same as proc->getP() if the program has not been replaced.
+			//Otherwise it has been deleted, and pipelines using it must be removed with SgTShaderPipeline::removeProgram(oldProgram)
+			GLuint oldProgram;
+			//The status of compilation and linkage
+			SgTShaderStatus status;
+			//The error log, empty if status is OK
+			SgTstring log;
+
+		};
+
+	private:
+
+		//How often files are checked if file system events are not available
+		static constexpr std::chrono::milliseconds POLL_INTERVAL = std::chrono::milliseconds(250);
+
+		/**
+		 * @brief A watched shader processor and its program parameter
+		*/
+		struct SgTWatchEntry {
+		public:
+
+			SgTShaderProc* proc;
+			SgTProgramPara arg;
+			//All files behind the shader processor
+			std::vector<SgTstring> file;
+
+		};
+		std::vector<SgTWatchEntry> entry;
+
+		//Protect everything shared with the watcher thread
+		std::mutex watchLock;
+		std::condition_variable watchSignal;
+		//All watched files and the number of entries using it
+		std::unordered_map<SgTstring, unsigned int> watchedFile;
+		//Changed files that have not been processed, and the time of the last event
+		std::unordered_map<SgTstring, std::chrono::steady_clock::time_point> pendingFile;
+
+		std::atomic<bool> running;
+		std::thread watcherThread;
+
+#ifdef __linux__
+		//The inotify instance
+		int notifyHandle = -1;
+		//Write to the pipe to wake the watcher thread up
+		int wakePipe[2] = { -1, -1 };
+		//The inotify watch of each watched directory, and the reverse
+		std::unordered_map<SgTstring, int> directoryWatch;
+		std::unordered_map<int, SgTstring> watchDirectory;
+#else
+		//The last modification time of every watched file
+		std::unordered_map<SgTstring, std::filesystem::file_time_type> modifiedTime;
+#endif
+
+		/**
+		 * @brief The watcher thread routine
+		*/
+		void watch();
+
+		/**
+		 * @brief Start watching a file, watchLock must be held
+		 * @param path The normalised path of the file
+		*/
+		void addFile(const SgTstring&);
+
+		/**
+		 * @brief Stop watching a file, watchLock must be held
+		 * @param path The normalised path of the file
+		*/
+		void removeFile(const SgTstring&);
+
+		/**
+		 * @brief Queue a change event of a file, watchLock must be held
+		 * @param path The normalised path of the file
+		*/
+		void notifyChange(const SgTstring&);
+
+	public:
+
+		//The time a file must stay unchanged before it is rebuilt
+		std::chrono::milliseconds SETTLE_TIME = std::chrono::milliseconds(100);
+
+		/**
+		 * @brief Initialise the watcher and start the watcher thread.
+		 * Throw exception if file system events cannot be initialised
+		*/
+		SgTShaderWatcher();
+
+		SgTShaderWatcher(const SgTShaderWatcher&) = delete;
+
+		SgTShaderWatcher& operator=(const SgTShaderWatcher&) = delete;
+
+		/**
+		 * @brief Stop the watcher thread
+		*/
+		~SgTShaderWatcher();
+
+		/**
+		 * @brief Start watching all source files of a shader processor.
+		 * The shader processor must stay alive until it is unwatched or the watcher is destroyed
+		 * @param proc The shader processor
+		 * @param arg The argument for the program before the program is linked, used when the program is rebuilt
+		*/
+		void addProgram(SgTShaderProc* const, SgTProgramPara = NULL);
+
+		/**
+		 * @brief Stop watching a shader processor
+		 * @param proc The shader processor
+		*/
+		void removeProgram(SgTShaderProc* const);
+
+		/**
+		 * @brief Rebuild all programs affected by files that have settled since the last call.
+		 * Only the changed shaders are recompiled, and a program is kept as it is if the rebuild fails.
+		 * A rebuilt program has a new handle, the old handle is given in the result so pipelines using it can be removed.
+		 * This function must be called from the thread that holds the OpenGL context, e.g. once per frame.
+		 * @param bufferSize The size of the buffer that is allocated for each error log
+		 * @return The result of each rebuilt program
+		*/
+		const std::vector<SgTReloadResult> process(const int = 1024);
+
+	};
+}
+#endif//_SgTShaderWatcher_H_
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+#ifndef _SgTShadowAtlas_H_
+#define _SgTShadowAtlas_H_
+
+#include "SgTDefineFile.h"
+
+#include <vector>
+#include <unordered_map>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief Pack the shadow maps of many lights into one large depth texture, so all shadows are rendered into the same framebuffer.
+	 * The atlas is a quadtree of square tiles with power-of-two sizes, each tile is sized by the coverage of the light on the screen.
+	 * Lights are identified by a key, and a light keeps its tile across frames as long as its size does not change by more than one level,
+	 * so the shadow map in the tile can be reused when nothing has moved.
+	 * Only the texture space is managed, creating the texture and rendering are left to the caller.
+	*/
+	class SgTShadowAtlas {
+	public:
+
+		/**
+		 * @brief A shadow view requesting a tile
+		*/
+		struct SgTShadowRequest {
+		public:
+
+			//The key identifying the light, or a face of the light
+			SgTHash key;
+			//The fraction of the screen area covered by the light from 0 to 1, the tile size is proportional to the square root
+			float coverage;
+
+		};
+
+		/**
+		 * @brief The tile of a shadow view in the atlas
+		*/
+		struct SgTShadowTile {
+		public:
+
+			//The rect in texel with the origin at the lower left corner, to be used as both viewport and scissor
+			GLint x, y;
+			GLsizei size;
+			//Transform shadow coordinate in [0, 1] into the atlas, uv * xy + zw
+			SgTvec4 uvTransform;
+			//If the light had the same tile in the last frame, the content of the tile is kept
+			bool reused;
+
+		};
+
+	private:
+
+		/**
+		 * @brief A tile allocated to a light
+		*/
+		struct SgTAllocation {
+		public:
+
+			//The node in the quadtree, and its level
+			size_t node;
+			unsigned int level;
+			GLint x, y;
+			//If the light requested a tile in the current update
+			bool requested;
+
+		};
+
+		//The state of a node in the quadtree
+		enum class SgTNodeState : unsigned char {
+			FREE = 0x00u,
+			SPLIT = 0x01u,
+			USED = 0x02u
+		};
+
+		//The size of the atlas, and the maximum and minimum tile size in texel
+		const unsigned int Size, MaxTile, MinTile;
+		//The level of the smallest tile, the root is level 0
+		unsigned int maxLevel;
+
+		//The complete quadtree stored level by level, the children of node n are 4n + 1 to 4n + 4
+		std::vector<SgTNodeState> node;
+		std::unordered_map<SgTHash, SgTAllocation> allocation;
+		//Scratch memory of update(), kept to reuse the capacity between frames
+		std::vector<unsigned int> requestLevel;
+		std::vector<std::pair<unsigned int, size_t>> pending;
+
+		/**
+		 * @brief Get the size of the tiles at a level
+		 * @param level The level
+		 * @return The size in texel
+		*/
+		inline const unsigned int getLevelSize(const unsigned int level) const {
+			return this->Size >> level;
+		}
+
+		/**
+		 * @brief Get the level of the tile to be allocated for a coverage
+		 * @param coverage The fraction of the screen area covered
+		 * @return The level
+		*/
+		const unsigned int getLevel(const float) const;
+
+		/**
+		 * @brief Find a free node at a level, nodes already split are searched first so large free nodes are kept
+		 * @param index The node to search from
+		 * @param level The level of the node
+		 * @param x, y The position of the node
+		 * @param target The level of the tile
+		 * @param result The allocation found
+		 * @return True if a node is found
+		*/
+		const bool allocateNode(const size_t, const unsigned int, const GLint, const GLint, const unsigned int, SgTAllocation&);
+
+		/**
+		 * @brief Free a node, and merge the parents whose children are all free
+		 * @param index The node
+		*/
+		void freeNode(size_t);
+
+		/**
+		 * @brief Fill the tile of an allocation
+		 * @param alloc The allocation
+		 * @param reused If the allocation is reused from the last update
+		 * @param tile The tile
+		*/
+		void fillTile(const SgTAllocation&, const bool, SgTShadowTile&) const;
+
+	public:
+
+		/**
+		 * @brief Create an empty atlas.
+		 * Throw exception if sizes are not power of two, or not minTile <= maxTile <= size
+		 * @param size The width and height of the atlas texture in texel
+		 * @param maxTile The size of the tile of a light covering the whole screen
+		 * @param minTile The smallest tile size
+		*/
+		SgTShadowAtlas(const unsigned int, const unsigned int, const unsigned int);
+
+		~SgTShadowAtlas();
+
+		/**
+		 * @brief Allocate tiles for all shadow views of a frame. If the tiles do not fit, they are all halved until they do.
+		 * Lights that keep their tile are placed first, then the others from the largest
+		 * tile to the smallest, a tile is halved until it fits. Tiles of lights not in the requests are freed.
+		 * Each key should appear once.
+		 * @param request The shadow views
+		 * @param count The number of shadow view
+		 * @param tile The tile of each shadow view, the size is 0 if the atlas is full even for the smallest tile
+		 * @return The number of shadow view that got a tile
+		*/
+		const size_t update(const SgTShadowRequest* const, const size_t, SgTShadowTile* const);
+
+		/**
+		 * @brief Find the tile of a light
+		 * @param key The key of the light
+		 * @param tile The tile, with reused set to true
+		 * @return True if the light has a tile
+		*/
+		const bool getTile(const SgTHash, SgTShadowTile&) const;
+
+		/**
+		 * @brief Free the tile of a light
+		 * @param key The key of the light
+		*/
+		void release(const SgTHash);
+
+		/**
+		 * @brief Free all tiles
+		*/
+		void clear();
+
+		/**
+		 * @brief Get the width and height of the atlas
+		 * @return The size in texel
+		*/
+		inline const unsigned int getSize() const {
+			return this->Size;
+		}
+
+		/**
+		 * @brief Get the number of tile allocated
+		 * @return The number of tile
+		*/
+		inline const size_t getTileCount() const {
+			return this->allocation.size();
+		}
+
+	};
+}
+#endif//_SgTShadowAtlas_H_
\ No newline at end of file
@@ -20,13 +20,38 @@ namespace SglToolkit {
 	 * area won't be.
 	*/
 	class SgTShadowBox {
-	private:
+	public:
+
+		/**
+		 * @brief The eight corners of the view frustum in world space, stored as structure of arrays so each axis fills one vector register.
+		 * Corners are ordered as far top right, far top left, far bottom right, far bottom left, then the same on the near plane.
+		*/
+		struct SgTFrustumCorner {
+		public:
+
+			alignas(32) float x[8];
+			alignas(32) float y[8];
+			alignas(32) float z[8];
+
+		};
+
+	protected:
 
 		//the camera, this needs to be updated in whenever the camera got updated
 		SgTCamera* const Camera;
 		SgTvec3 LightDirection;
 
-		//parameters that define the shadow box that is bounded by the camera view frustum
+		//the light view matrix, which is rotation only, and the shadow box is bounded in this light space
+		SgTmat4 lightView;
+		//the scene bounds in world space the shadow box is clipped against, if supplied
+		bool sceneBounded = false;
+		SgTvec3 sceneMin, sceneMax;
+
+		//the corners of the view frustum in world space, and the planes of the view frustum with the normal pointing inwards
+		SgTFrustumCorner frustumCorner;
+		SgTvec4 frustumPlane[6];
+
+		//parameters that define the shadow box in light space that is bounded by the camera view frustum
 		float minX, maxX,
 			minY, maxY,
 			minZ, maxZ;
@@ -34,6 +59,40 @@ namespace SglToolkit {
 		//The dimension of the near and far plane of the camera view frustum (perspective projection)
 		float nearWidth, nearHeight, farWidth, farHeight;
 
+		/**
+		 * @brief Everything the bounds depend on, recorded when the bounds are computed
+		*/
+		struct SgTUpdateState {
+		public:
+
+			SgTvec3 position, front, up, lightDirection;
+			float zoom, aspect;
+			float nearPlane, shadowDistance, offset;
+			SgTvec4 upAxis, forwardAxis;
+			bool sceneBounded;
+			SgTvec3 sceneMin, sceneMax;
+
+		};
+		SgTUpdateState lastState;
+		//If lastState holds the state of the current bounds
+		bool stateRecorded = false;
+		//If the last update reused the bounds, and the version of the bounds
+		bool shadowValid = false;
+		unsigned long long version = 0ull;
+
+		/**
+		 * @brief Check if the bounds of the last update can be reused, the result is kept as the shadow map valid flag
+		 * @param aspect - The aspect ratio of the camera perspective
+		 * @return True if CACHE_BOUNDS is set, and nothing has changed beyond CACHE_TOLERANCE since the bounds were computed
+		*/
+		virtual const bool reuseBounds(const float);
+
+		/**
+		 * @brief Record the state of the bounds just computed, and advance the version
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		void recordState(const float);
+
 		/**
 		 * @brief Get the camera rotation matrix by removing the translation from the camera view matrix
 		 * @return The camera rotation matrix
@@ -52,26 +111,86 @@ namespace SglToolkit {
 		*/
 		void calcViewFrustumPlanes(const float);
 
+		/**
+		 * @brief Calculates the width and height of the near and far planes of the view frustum of a camera
+		 * @param camera - The camera
+		 * @param aspect - The aspect ratio of the camera perspective
+		*/
+		void calcViewFrustumPlanes(SgTCamera* const, const float);
+
+		/**
+		 * @brief Calculates the corners of the view frustum of a camera bounded by SHADOW_DISTANCE, the dimension of the planes is updated
+		 * @param camera - The camera
+		 * @param aspect - The aspect ratio of the camera perspective
+		 * @param corner - the positions of the vertices of the frustum in world space.
+		*/
+		void calcCameraFrustum(SgTCamera* const, const float, SgTFrustumCorner&);
+
 		/**
 		 * @brief Calculates the position of the vertex at each corner of the view frustum
-		 * in world space (8 vertices in total, so this returns 8 positions).
-		 * @param rotation - camera's rotation.
+		 * in world space (8 vertices in total), all corners are computed at once in vector registers.
 		 * @param forwardVector - the direction that the camera is aiming, and thus the direction of the frustum.
 		 * @param upVector - the direction that the camera's up is aiming, and thus the direction of the up frustum.
 		 * @param centerNear - the center point of the frustum's near plane.
 		 * @param centerFar - the center point of the frustum's (possibly adjusted) far plane.
-		 * @return The positions of the vertices of the frustum in world space.
+		 * @param corner - the positions of the vertices of the frustum in world space.
 		 */
-		const SgTvec4* const calcFrustumVertices(SgTmat4, SgTvec3, SgTvec3, SgTvec3, SgTvec3);
+		void calcFrustumVertices(const SgTvec3, const SgTvec3, const SgTvec3, const SgTvec3, SgTFrustumCorner&) const;
 
 		/**
-		 * @brief Calculates one of the corner vertices of the view frustum in world space
-		 * @param startPoint - the starting center point on the view frustum.
-		 * @param direction - the direction of the corner from the start point.
-		 * @param scale - the distance of the corner from the start point.
-		 * @return The relevant corner vertex of the view frustum in world space.
-		 */
-		const SgTvec4 calcFrustumCorner(SgTvec3, SgTvec3, float);
+		 * @brief Calculate the light view matrix from the light direction
+		*/
+		void calcLightView();
+
+		/**
+		 * @brief Calculate the planes of a view frustum from its corners
+		 * @param corner - the positions of the vertices of the frustum in world space
+		 * @param plane - the 6 planes in the order of near, far, left, right, top and bottom, with the normal pointing inwards
+		*/
+		static void calcFrustumPlane(const SgTFrustumCorner&, SgTvec4* const);
+
+		/**
+		 * @brief Set the bounds of the shadow box to the bounds of the corners of a view frustum in light space
+		 * @param corner - the positions of the vertices of the frustum in world space
+		*/
+		void boundLightSpace(const SgTFrustumCorner&);
+
+		/**
+		 * @brief Clip the bounds of the shadow box against the scene bounds if supplied
+		*/
+		void clipSceneBounds();
+
+		/**
+		 * @brief Bound the corners of the view frustum in light space, and clip the bounds against the scene bounds if supplied
+		*/
+		void fitLightSpace();
+
+		/**
+		 * @brief Find the shadow casters whose extrusion along the light direction intersects any of the view frustums, see cullCaster()
+		 * @param plane - the planes of the view frustums, 6 per view frustum
+		 * @param viewCount - the number of view frustum
+		 * @param min - The minimum corner of the bounding box of each object in world space
+		 * @param max - The maximum corner of the bounding box of each object in world space
+		 * @param count - The number of object
+		 * @param index - The index of the casters in ascending order
+		 * @return The number of caster
+		*/
+		const size_t cullExtrusion(const SgTvec4* const, const unsigned int, const SgTvec3* const, const SgTvec3* const, const size_t, unsigned int* const) const;
+
+		/**
+		 * @brief Check if another shadow box is bounded by the same view frustum, such that the bounds can be copied
+		 * @param box - the other shadow box, which has been updated with the same aspect ratio
+		 * @return True if both boxes have the same view frustum
+		*/
+		virtual const bool hasSameFrustum(const SgTShadowBox&) const;
+
+		/**
+		 * @brief Take the view frustum from another shadow box bounded by the same view frustum, instead of updating.
+		 * Only the fitting in light space is done, so the other box may have a different light.
+		 * @param box - the other shadow box, which has been updated
+		 * @param aspect - the aspect ratio of the camera perspective
+		*/
+		virtual void copyBounds(const SgTShadowBox&, const float);
 
 	public:
 
@@ -79,6 +198,11 @@ namespace SglToolkit {
 		float OFFSET = 0.0f;
 		float SHADOW_DISTANCE = 1.0f;
 		float NEAR_PLANE = 1.0f;
+		//Reuse the bounds when the camera and the light have not moved since the last update, such that the shadow map can be reused.
+		//Camera position, direction vectors, zoom degree and aspect ratio are compared component-wise within the tolerance,
+		//other settings must be equal.
+		bool CACHE_BOUNDS = false;
+		float CACHE_TOLERANCE = 1.0e-4f;
 
 		SgTvec4 UP = SgTvec4(0.0f, 1.0f, 0.0f, 0.0f);
 		SgTvec4 FORWARD = SgTvec4(0.0f, 0.0f, -1.0f, 0.0f);
@@ -97,7 +221,61 @@ namespace SglToolkit {
 		*/
 		SgTShadowBox(SgTCamera* const, const SgTvec3, const float, const float);
 
-		~SgTShadowBox();
+		virtual ~SgTShadowBox();
+
+		/**
+		 * @brief Set the direction of the light, the shadow box needs to be updated
+		 * @param lightDir - The direction of the light
+		*/
+		void setLightDirection(const SgTvec3);
+
+		/**
+		 * @brief Set the bounds of the scene in world space. The shadow box is clipped against the bounds, such that the area
+		 * outside the scene does not waste shadow map resolution, and it is extended towards the light up to the bounds so every
+		 * caster in the scene is inside the box. The shadow box needs to be updated.
+		 * @param min - The minimum corner of the scene
+		 * @param max - The maximum corner of the scene
+		*/
+		void setSceneBounds(const SgTvec3, const SgTvec3);
+
+		/**
+		 * @brief Stop clipping the shadow box against the scene bounds, the shadow box needs to be updated
+		*/
+		void clearSceneBounds();
+
+		/**
+		 * @brief Find the shadow casters from axis-aligned bounding boxes of objects, an object is a caster if its extrusion along
+		 * the light direction intersects the view frustum bounded by SHADOW_DISTANCE, and it is inside the shadow box.
+		 * The test is conservative, an object may be kept when its extrusion only passes the corner of the view frustum.
+		 * @param min - The minimum corner of the bounding box of each object in world space
+		 * @param max - The maximum corner of the bounding box of each object in world space
+		 * @param count - The number of object
+		 * @param index - The index of the casters in ascending order, it must have space for count indices
+		 * @return The number of caster
+		*/
+		virtual const size_t cullCaster(const SgTvec3* const, const SgTvec3* const, const size_t, unsigned int* const) const;
+
+		/**
+		 * @brief Check if the shadow map rendered with the bounds before the last update is still valid, which is when the last update
+		 * reused the bounds. The shadow pass can be skipped if the shadow casters have not moved either.
+		 * @return True if the shadow map is still valid
+		*/
+		inline const bool isShadowValid() const {
+			return this->shadowValid;
+		}
+
+		/**
+		 * @brief Get the version of the bounds, which is advanced every time the bounds are computed
+		 * @return The version
+		*/
+		inline const unsigned long long getVersion() const {
+			return this->version;
+		}
+
+		/**
+		 * @brief Compute the bounds in the next update even if nothing has changed, e.g. when the shadow casters have moved
+		*/
+		void invalidate();
 
 		/**
 		 * @brief Calculates the center of the "view cuboid" in world space
@@ -112,10 +290,21 @@ namespace SglToolkit {
 		 * (within a certain range) will cast shadows.
 		 * @param aspect - The aspect ratio of the camera perspective
 		*/
-		void update(const float);
+		virtual void update(const float);
+
+		/**
+		 * @brief Update many shadow boxes in one call, nothing is allocated.
+		 * Consecutive boxes that share the same camera and settings, e.g. one box per light for the same view,
+		 * copy the view frustum instead of computing it again and only fit it in their own light space, so boxes should be grouped by camera.
+		 * Boxes whose bounds can be reused, see CACHE_BOUNDS, are not updated at all.
+		 * @param box - the shadow boxes
+		 * @param aspect - the aspect ratio of the camera perspective of each box
+		 * @param count - the number of shadow box
+		*/
+		static void updateBatch(SgTShadowBox* const* const, const float* const, const size_t);
 
 		/**
-		 * @brief Return the width of the shadow box (orthographic projection area).
+		 * @brief Return the width of the shadow box in light space (orthographic projection area).
 		 * @return The width
 		*/
 		inline const float getWidth() {
@@ -123,7 +312,7 @@ namespace SglToolkit {
 		}
 
 		/**
-		 * @brief Return the height of the shadow box (orthographic projection area).
+		 * @brief Return the height of the shadow box in light space (orthographic projection area).
 		 * @return The height
 		*/
 		inline const float getHeight() {
@@ -131,7 +320,7 @@ namespace SglToolkit {
 		}
 
 		/**
-		 * @brief Return the depth(or namely length) of the shadow box (orthographic projection area).
+		 * @brief Return the depth(or namely length) of the shadow box in light space (orthographic projection area).
 		 * @return The depth
 		*/
 		inline const float getDepth() {
@@ -139,29 +328,29 @@ namespace SglToolkit {
 		}
 
 		/**
-		 * @brief Return the view matrix of the light
+		 * @brief Return the view matrix of the light, the light is parallel so the view matrix is rotation only
 		 * @return The light's view matrix
 		*/
 		inline const SgTmat4 getLightView() {
-			const SgTvec3 lightPos = this->Camera->getPosition();//althouh we are using parallel light, the view matrix requires light position
-			//so we place the light at a random location in the light direction, and the random location I choose is the cuboid center
-			const SgTvec3 lightCenter = lightPos + this->LightDirection;//light direction has already been normlaised
-			const SgTvec3 lightRight = glm::normalize(glm::cross(this->LightDirection, SgTvec3(this->UP)));
-			const SgTvec3 lightUp = normalize(cross(lightRight, this->LightDirection));
-
-			return glm::lookAt(lightPos, lightCenter, lightUp);
+			return this->lightView;
 		}
 
 		/**
-		 * @brief Return the projection matrix of the light
+		 * @brief Return the projection matrix of the light, which covers the shadow box in light space
 		 * @return The light's projection matrix
 		*/
 		inline const SgTmat4 getLightProjection() {
-			const float width = this->getWidth();
-			const float height = this->getHeight();
-			const float depth = this->getDepth();
+			//the light looks at -z, so the near plane is at the maximum z
+			return glm::ortho(this->minX, this->maxX, this->minY, this->maxY, -this->maxZ, -this->minZ);
+		}
 
-			return glm::ortho(width * -0.5f, width * 0.5f, height * -0.5f, height * 0.5f, depth * -0.5f, depth * 0.5f);
+		/**
+		 * @brief Return a plane of the view frustum bounded by SHADOW_DISTANCE in world space
+		 * @param index - The index of the plane, in the order of near, far, left, right, top and bottom
+		 * @return The plane (a, b, c, d) such that ax + by + cz + d >= 0 is inside the view frustum
+		*/
+		inline const SgTvec4& getFrustumPlane(const unsigned int index) const {
+			return this->frustumPlane[index];
 		}
 	};
 }
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef _SgTSourceCache_H_
+#define _SgTSourceCache_H_
+
+#include "SgTFileMapping.h"
+
+#include <unordered_map>
+#include <filesystem>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A cache of memory mapped shader source files.
+	 * Each file is mapped once and shared by every shader that reads it, until the file is modified on disk.
+	*/
+	class SgTSourceCache {
+	public:
+
+		/**
+		 * @brief A read-only view of a source file, it stays valid until the file is remapped or released from the cache
+		*/
+		struct SgTSourceView {
+		public:
+
+			//The first character of the source, not null-terminated
+			const char* data;
+			//The number of character in the source
+			size_t length;
+
+		};
+
+	private:
+
+		/**
+		 * @brief A mapped file and the modification time when it was mapped
+		*/
+		struct SgTCacheEntry {
+		public:
+
+			SgTFileMapping mapping;
+			std::filesystem::file_time_type modifiedTime;
+
+		};
+
+		//All mapped files, keyed by path
+		std::unordered_map<SgTstring, SgTCacheEntry> entry;
+
+	public:
+
+		/**
+		 * @brief Initialise an empty source cache
+		*/
+		SgTSourceCache();
+
+		~SgTSourceCache();
+
+		/**
+		 * @brief Get the content of a source file.
+		 * The file is mapped on first access, and remapped if it has been modified since.
+		 * Throw exception if the file cannot be opened
+		 * @param path The path of the file
+		 * @return The view of the file content
+		*/
+		const SgTSourceView getSource(const SgTstring&);
+
+		/**
+		 * @brief Unmap a file, all views of the file become invalid
+		 * @param path The path of the file
+		*/
+		void release(const SgTstring&);
+
+		/**
+		 * @brief Unmap all files, all views become invalid
+		*/
+		void clear();
+
+	};
+}
+#endif//_SgTSourceCache_H_
\ No newline at end of file
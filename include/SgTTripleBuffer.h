@@ -0,0 +1,88 @@
+#pragma once
+#ifndef _SgTTripleBuffer_H_
+#define _SgTTripleBuffer_H_
+
+#include <atomic>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A wait-free triple buffer passing the latest value from one writer thread to one reader thread.
+	 * The writer fills the back slot and swaps it with the middle slot, the reader swaps its front slot with the middle slot only when
+	 * a new value has been published. Neither side ever waits for the other, the reader may skip values but always sees a complete one.
+	 * @tparam T The value type
+	*/
+	template<typename T>
+	class SgTTripleBuffer {
+	private:
+
+		static constexpr unsigned int INDEX = 0x03u;
+		//Set on the middle index when it holds a value the reader has not taken
+		static constexpr unsigned int FRESH = 0x04u;
+		static constexpr size_t CACHE_LINE = 64u;
+
+		T slot[3];
+		//The index of the middle slot, shared by both sides
+		alignas(CACHE_LINE) std::atomic<unsigned int> middle;
+		//The index of the slot owned by the writer
+		alignas(CACHE_LINE) unsigned int back;
+		//The index of the slot owned by the reader
+		alignas(CACHE_LINE) unsigned int front;
+
+	public:
+
+		/**
+		 * @brief Initialise the buffer, the reader sees a default value until the first publish
+		*/
+		SgTTripleBuffer() : slot(), middle(1u), back(0u), front(2u) {
+
+		}
+
+		~SgTTripleBuffer() {
+
+		}
+
+		SgTTripleBuffer(const SgTTripleBuffer&) = delete;
+
+		SgTTripleBuffer& operator=(const SgTTripleBuffer&) = delete;
+
+		/**
+		 * @brief Get the slot to be written, only called by the writer thread. The content is an older value, not the last published one
+		 * @return The slot
+		*/
+		inline T& getWriteBuffer() {
+			return this->slot[this->back];
+		}
+
+		/**
+		 * @brief Publish the slot written, only called by the writer thread
+		*/
+		inline void publish() {
+			this->back = this->middle.exchange(this->back | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		/**
+		 * @brief Take the latest published value, only called by the reader thread
+		 * @return The value, which stays unchanged until the next acquire
+		*/
+		inline const T& acquire() {
+			if ((this->middle.load(std::memory_order_relaxed) & FRESH) != 0u) {
+				this->front = this->middle.exchange(this->front, std::memory_order_acq_rel) & INDEX;
+			}
+			return this->slot[this->front];
+		}
+
+		/**
+		 * @brief Check if a value has been published and not yet acquired
+		 * @return True if there is a new value
+		*/
+		inline const bool hasNew() const {
+			return (this->middle.load(std::memory_order_relaxed) & FRESH) != 0u;
+		}
+
+	};
+}
+#endif//_SgTTripleBuffer_H_
\ No newline at end of file
@@ -99,6 +99,81 @@ namespace SglToolkit {
 		//The number of element in the index list of the unit plane
 		const static unsigned int UNITPLANE_INDICES_SIZE = 6;
 
+		//The offset basis of 64-bit FNV-1a hash
+		constexpr static SgTHash FNV_OFFSET = 14695981039346656037ull;
+		//The prime of 64-bit FNV-1a hash
+		constexpr static SgTHash FNV_PRIME = 1099511628211ull;
+
+		/**
+		 * @brief Hash a block of memory using 64-bit FNV-1a, it can be evaluated at compile time
+		 * @param data The pointer to the data
+		 * @param length The number of byte in the data
+		 * @param seed The hash to continue from, such that multiple blocks can be chained
+		 * @return The hash code
+		*/
+		constexpr static SgTHash hashFNV(const char* const data, const size_t length, SgTHash seed = SgTUtils::FNV_OFFSET) {
+			for (size_t i = 0; i < length; i++) {
+				seed ^= static_cast<unsigned char>(data[i]);
+				seed *= SgTUtils::FNV_PRIME;
+			}
+			return seed;
+		}
+
+		/**
+		 * @brief Hash a null-terminated string using 64-bit FNV-1a, it can be evaluated at compile time
+		 * @param str The string to be hashed
+		 * @return The hash code
+		*/
+		constexpr static SgTHash hashFNV(const char* const str) {
+			size_t length = 0;
+			while (str[length] != '\0') {
+				length++;
+			}
+			return SgTUtils::hashFNV(str, length);
+		}
+
+		/**
+		 * @brief Hash a string using 64-bit FNV-1a
+		 * @param str The string to be hashed
+		 * @param seed The hash to continue from
+		 * @return The hash code
+		*/
+		static SgTHash hashFNV(const SgTstring& str, const SgTHash seed = SgTUtils::FNV_OFFSET) {
+			return SgTUtils::hashFNV(str.data(), str.length(), seed);
+		}
+
+		/**
+		 * @brief Mix an integral value into an existing hash code, byte by byte
+		 * @param seed The hash to continue from
+		 * @param value The value to be mixed
+		 * @return The new hash code
+		*/
+		constexpr static SgTHash hashCombine(SgTHash seed, unsigned long long value) {
+			for (int i = 0; i < 8; i++) {
+				seed ^= value & 0xFFull;
+				seed *= SgTUtils::FNV_PRIME;
+				value >>= 8;
+			}
+			return seed;
+		}
+
+		/**
+		 * @brief Check if the current OpenGL context supports an extension
+		 * @param name The name of the extension, e.g. "GL_KHR_parallel_shader_compile"
+		 * @return True if the extension is supported
+		*/
+		static const bool hasExtension(const char* const name) {
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; i++) {
+				const char* const ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+				if (ext != NULL && SgTstring(ext) == name) {
+					return true;
+				}
+			}
+			return false;
+		}
+
 		//The full debug output callback function for the OpenGL debug callback, auto-printed arrived information
 		const static void debugOutput(unsigned int src, unsigned int type, unsigned int id, unsigned int severity, int length, const char* log, const void* user_param) {
 			auto const src_str = [src]() {
@@ -12,7 +12,7 @@ SgTCamera::SgTRange::~SgTRange() {
 }
 
 SgTCamera::SgTCamera(const float yaw, const float pitch, const float movementSpeed,
-	const float mouseSens, const float zoom, const SgTvec3 position, const SgTvec3 up, const SgTvec3 front) : World_Up(up){
+	const float mouseSens, const float zoom, const SgTvec3 position, const SgTvec3 up, const SgTvec3 front) : World_Up(up), snapshot(nullptr) {
 	this->Yaw = yaw;
 	this->Pitch = pitch;
 	this->MovementSpeed = movementSpeed;
@@ -20,15 +20,103 @@ SgTCamera::SgTCamera(const float yaw, const float pitch, const float movementSpe
 	this->Zoom = zoom;
 	this->Position = position;
 	this->Front = front;
+	this->Aspect = SgTCamera::ASPECT;
+	this->NearPlane = SgTCamera::NEAR_PLANE;
+	this->FarPlane = SgTCamera::FAR_PLANE;
 	//right and up are calculated
 }
 
 SgTCamera::~SgTCamera() {
+	delete this->snapshot.load(std::memory_order_acquire);
+}
 
+void SgTCamera::updateMatrix() {
+	if (this->matrixVersion == this->version) {
+		return;
+	}
+	this->view = glm::lookAt(this->Position, this->Position + this->Front, this->Up);
+	this->projection = glm::perspective(glm::radians(this->Zoom), this->Aspect, this->NearPlane, this->FarPlane);
+	this->viewProjection = this->projection * this->view;
+	//the view matrix is rigid, so the inverse is the transposed rotation with the position as translation
+	this->inverseView = glm::transpose(SgTmat4(SgTmat3(this->view)));
+	this->inverseView[3] = SgTvec4(this->Position, 1.0f);
+	this->matrixVersion = this->version;
 }
 
 const SgTmat4 SgTCamera::getViewMat() {
-	return glm::lookAt(this->Position, this->Position + this->Front, this->Up);
+	this->updateMatrix();
+	return this->view;
+}
+
+void SgTCamera::setProjection(const float aspect, const float nearPlane, const float farPlane) {
+	this->Aspect = aspect;
+	this->NearPlane = nearPlane;
+	this->FarPlane = farPlane;
+	this->markDirty();
+}
+
+const SgTmat4& SgTCamera::getProjectionMat() {
+	this->updateMatrix();
+	return this->projection;
+}
+
+const SgTmat4& SgTCamera::getViewProjectionMat() {
+	this->updateMatrix();
+	return this->viewProjection;
+}
+
+const SgTmat4& SgTCamera::getInverseViewMat() {
+	this->updateMatrix();
+	return this->inverseView;
+}
+
+const SgTmat4& SgTCamera::getInverseViewProjectionMat() {
+	if (this->inverseVersion != this->version) {
+		this->updateMatrix();
+		this->inverseViewProjection = glm::inverse(this->viewProjection);
+		this->inverseVersion = this->version;
+	}
+	return this->inverseViewProjection;
+}
+
+void SgTCamera::publish() {
+	if (this->publishedVersion == this->version) {
+		return;
+	}
+	this->updateMatrix();
+	SgTTripleBuffer<SgTCameraState>* buffer = this->snapshot.load(std::memory_order_relaxed);
+	if (buffer == nullptr) {
+		//only the writer allocates, the reader sees the buffer once it is stored
+		buffer = new SgTTripleBuffer<SgTCameraState>();
+		this->snapshot.store(buffer, std::memory_order_release);
+	}
+	SgTCameraState& state = buffer->getWriteBuffer();
+	state.position = this->Position;
+	state.front = this->Front;
+	state.up = this->Up;
+	state.right = this->Right;
+	state.yaw = this->Yaw;
+	state.pitch = this->Pitch;
+	state.zoom = this->Zoom;
+	state.aspect = this->Aspect;
+	state.nearPlane = this->NearPlane;
+	state.farPlane = this->FarPlane;
+	state.view = this->view;
+	state.projection = this->projection;
+	state.viewProjection = this->viewProjection;
+	state.inverseView = this->inverseView;
+	state.version = this->version;
+	buffer->publish();
+	this->publishedVersion = this->version;
+}
+
+const SgTCamera::SgTCameraState& SgTCamera::acquireSnapshot() {
+	SgTTripleBuffer<SgTCameraState>* const buffer = this->snapshot.load(std::memory_order_acquire);
+	if (buffer == nullptr) {
+		static const SgTCameraState empty = SgTCameraState();
+		return empty;
+	}
+	return buffer->acquire();
 }
 
 const SgTvec3 SgTCamera::getFront() const {
@@ -53,4 +141,16 @@ const float SgTCamera::getPitch() const {
 
 const float SgTCamera::getZoomDeg() const {
 	return this->Zoom;
+}
+
+const float SgTCamera::getAspect() const {
+	return this->Aspect;
+}
+
+const float SgTCamera::getNearPlane() const {
+	return this->NearPlane;
+}
+
+const float SgTCamera::getFarPlane() const {
+	return this->FarPlane;
 }
\ No newline at end of file
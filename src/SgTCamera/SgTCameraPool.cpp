@@ -0,0 +1,240 @@
+#include "SgTCamera/SgTCameraPool.h"
+#include "SgTSIMD.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace SglToolkit;
+
+SgTCameraPool::SgTCameraPool(const size_t capacity) : Capacity(capacity), Stride((capacity + 7u) & ~static_cast<size_t>(7u)),
+	storage(((capacity + 7u) & ~static_cast<size_t>(7u)) * SgTCameraPool::ARRAY_COUNT + SgTSIMD::ALIGNMENT / sizeof(float), 0.0f) {
+	//align the first array, every array after it is aligned as the stride is a multiple of 8
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(this->storage.data());
+	const std::uintptr_t aligned = (address + SgTSIMD::ALIGNMENT - 1u) & ~static_cast<std::uintptr_t>(SgTSIMD::ALIGNMENT - 1u);
+	float* const first = this->storage.data() + (aligned - address) / sizeof(float);
+	for (unsigned int a = 0u; a < SgTCameraPool::ARRAY_COUNT; a++) {
+		this->array[a] = first + a * this->Stride;
+	}
+}
+
+SgTCameraPool::~SgTCameraPool() {
+
+}
+
+const size_t SgTCameraPool::add(const float yaw, const float pitch, const SgTvec3 position, const float zoom) {
+	if (this->count == this->Capacity) {
+		throw "CameraPoolFullException";
+	}
+	const size_t index = this->count++;
+	this->array[SgTCameraPool::YAW][index] = yaw;
+	this->array[SgTCameraPool::PITCH][index] = pitch;
+	this->array[SgTCameraPool::ZOOM][index] = zoom;
+	this->array[SgTCameraPool::POSITION_X][index] = position.x;
+	this->array[SgTCameraPool::POSITION_Y][index] = position.y;
+	this->array[SgTCameraPool::POSITION_Z][index] = position.z;
+	return index;
+}
+
+void SgTCameraPool::clear() {
+	this->count = 0;
+	std::memset(this->array[0], 0, sizeof(float) * this->Stride * SgTCameraPool::ARRAY_COUNT);
+}
+
+void SgTCameraPool::rotate(const float* const Xoffset, const float* const Yoffset, const bool limitPitch) {
+	float* const yaw = this->array[SgTCameraPool::YAW];
+	float* const pitch = this->array[SgTCameraPool::PITCH];
+	size_t i = 0;
+#if defined(SgT_SIMD_AVX2)
+	const __m256 sens = _mm256_set1_ps(this->MOUSE_SENSITIVITY);
+	const __m256 turn = _mm256_set1_ps(360.0f), negTurn = _mm256_set1_ps(-360.0f);
+	const __m256 maxPitch = _mm256_set1_ps(89.0f), minPitch = _mm256_set1_ps(-89.0f);
+	for (; i + 8u <= this->count; i += 8u) {
+		__m256 y = _mm256_add_ps(_mm256_load_ps(yaw + i), _mm256_mul_ps(_mm256_loadu_ps(Xoffset + i), sens));
+		__m256 p = _mm256_add_ps(_mm256_load_ps(pitch + i), _mm256_mul_ps(_mm256_loadu_ps(Yoffset + i), sens));
+		//a full turn resets the yaw
+		const __m256 reset = _mm256_or_ps(_mm256_cmp_ps(y, turn, _CMP_GE_OQ), _mm256_cmp_ps(y, negTurn, _CMP_LE_OQ));
+		y = _mm256_andnot_ps(reset, y);
+		if (limitPitch) {
+			p = _mm256_min_ps(_mm256_max_ps(p, minPitch), maxPitch);
+		}
+		_mm256_store_ps(yaw + i, y);
+		_mm256_store_ps(pitch + i, p);
+	}
+#endif
+	//the remaining cameras
+	for (; i < this->count; i++) {
+		yaw[i] += Xoffset[i] * this->MOUSE_SENSITIVITY;
+		pitch[i] += Yoffset[i] * this->MOUSE_SENSITIVITY;
+		if (yaw[i] >= 360.0f || yaw[i] <= -360.0f) {
+			yaw[i] = 0.0f;
+		}
+		if (limitPitch) {
+			pitch[i] = glm::clamp(pitch[i], -89.0f, 89.0f);
+		}
+	}
+}
+
+void SgTCameraPool::update() {
+	const float* const yaw = this->array[SgTCameraPool::YAW];
+	const float* const pitch = this->array[SgTCameraPool::PITCH];
+	float* const frontX = this->array[SgTCameraPool::FRONT_X];
+	float* const frontY = this->array[SgTCameraPool::FRONT_Y];
+	float* const frontZ = this->array[SgTCameraPool::FRONT_Z];
+	float* const rightX = this->array[SgTCameraPool::RIGHT_X];
+	float* const rightY = this->array[SgTCameraPool::RIGHT_Y];
+	float* const rightZ = this->array[SgTCameraPool::RIGHT_Z];
+	float* const upX = this->array[SgTCameraPool::UP_X];
+	float* const upY = this->array[SgTCameraPool::UP_Y];
+	float* const upZ = this->array[SgTCameraPool::UP_Z];
+
+	//with the world up of (0, 1, 0), front is (cy * cp, sp, sy * cp), right is normalize(cross(front, world up)) = (-sy, 0, cy) * sign(cp)
+	//and up is cross(right, front), both are already unit vectors so nothing needs to be normalised
+#if defined(SgT_SIMD_AVX2)
+	const __m256 radian = _mm256_set1_ps(glm::radians(1.0f));
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	//the padding lanes are computed as well, they are never read
+	for (size_t i = 0; i < this->count; i += 8u) {
+		__m256 sy, cy, sp, cp;
+		SgTSIMD::sincos8(_mm256_mul_ps(_mm256_load_ps(yaw + i), radian), sy, cy);
+		SgTSIMD::sincos8(_mm256_mul_ps(_mm256_load_ps(pitch + i), radian), sp, cp);
+
+		const __m256 fx = _mm256_mul_ps(cy, cp), fz = _mm256_mul_ps(sy, cp);
+		const __m256 sign = _mm256_and_ps(cp, signMask);
+		const __m256 rx = _mm256_xor_ps(_mm256_xor_ps(sy, signMask), sign), rz = _mm256_xor_ps(cy, sign);
+		_mm256_store_ps(frontX + i, fx);
+		_mm256_store_ps(frontY + i, sp);
+		_mm256_store_ps(frontZ + i, fz);
+		_mm256_store_ps(rightX + i, rx);
+		_mm256_store_ps(rightY + i, _mm256_setzero_ps());
+		_mm256_store_ps(rightZ + i, rz);
+		_mm256_store_ps(upX + i, _mm256_xor_ps(_mm256_mul_ps(rz, sp), signMask));
+		_mm256_store_ps(upY + i, _mm256_sub_ps(_mm256_mul_ps(rz, fx), _mm256_mul_ps(rx, fz)));
+		_mm256_store_ps(upZ + i, _mm256_mul_ps(rx, sp));
+	}
+#else
+	for (size_t i = 0; i < this->count; i++) {
+		const float y = glm::radians(yaw[i]), p = glm::radians(pitch[i]);
+		const float sy = glm::sin(y), cy = glm::cos(y), sp = glm::sin(p), cp = glm::cos(p);
+		const float sign = cp < 0.0f ? -1.0f : 1.0f;
+
+		const float fx = cy * cp, fz = sy * cp;
+		const float rx = -sy * sign, rz = cy * sign;
+		frontX[i] = fx;
+		frontY[i] = sp;
+		frontZ[i] = fz;
+		rightX[i] = rx;
+		rightY[i] = 0.0f;
+		rightZ[i] = rz;
+		upX[i] = -rz * sp;
+		upY[i] = rz * fx - rx * fz;
+		upZ[i] = rx * sp;
+	}
+#endif
+}
+
+void SgTCameraPool::move(const unsigned int* const movementMask, const float deltaTime) {
+	const float velocity = this->MOVEMENT_SPEED * deltaTime;
+	float* const position[3] = {
+		this->array[SgTCameraPool::POSITION_X], this->array[SgTCameraPool::POSITION_Y], this->array[SgTCameraPool::POSITION_Z]
+	};
+	const float* const front[3] = {
+		this->array[SgTCameraPool::FRONT_X], this->array[SgTCameraPool::FRONT_Y], this->array[SgTCameraPool::FRONT_Z]
+	};
+	const float* const right[3] = {
+		this->array[SgTCameraPool::RIGHT_X], this->array[SgTCameraPool::RIGHT_Y], this->array[SgTCameraPool::RIGHT_Z]
+	};
+	constexpr unsigned int forwardBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::FORWARD);
+	constexpr unsigned int backwardBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::BACKWARD);
+	constexpr unsigned int leftBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::LEFT);
+	constexpr unsigned int rightBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::RIGHT);
+	constexpr unsigned int upBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::UP);
+	constexpr unsigned int downBit = SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::DOWN);
+
+	size_t i = 0;
+#if defined(SgT_SIMD_AVX2)
+	const __m256 one = _mm256_set1_ps(1.0f), speed = _mm256_set1_ps(velocity);
+	//1 if the direction is held, otherwise 0
+	const auto held = [one](const __m256i mask, const unsigned int bit) {
+		const __m256i b = _mm256_set1_epi32(static_cast<int>(bit));
+		return _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(mask, b), b)), one);
+	};
+	for (; i + 8u <= this->count; i += 8u) {
+		const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(movementMask + i));
+		const __m256 forward = _mm256_sub_ps(held(mask, forwardBit), held(mask, backwardBit));
+		const __m256 side = _mm256_sub_ps(held(mask, rightBit), held(mask, leftBit));
+		const __m256 vertical = _mm256_sub_ps(held(mask, upBit), held(mask, downBit));
+		for (int a = 0; a < 3; a++) {
+			__m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(front[a] + i), forward), _mm256_mul_ps(_mm256_load_ps(right[a] + i), side));
+			if (a == 1) {
+				v = _mm256_add_ps(v, vertical);
+			}
+			_mm256_store_ps(position[a] + i, _mm256_add_ps(_mm256_load_ps(position[a] + i), _mm256_mul_ps(v, speed)));
+		}
+	}
+#endif
+	//the remaining cameras
+	for (; i < this->count; i++) {
+		const unsigned int mask = movementMask[i];
+		if (mask == 0u) {
+			continue;
+		}
+		const auto held = [mask](const unsigned int bit) {
+			return (mask & bit) != 0u ? 1.0f : 0.0f;
+		};
+		const float forward = held(forwardBit) - held(backwardBit);
+		const float side = held(rightBit) - held(leftBit);
+		const float vertical = held(upBit) - held(downBit);
+		for (int a = 0; a < 3; a++) {
+			float v = front[a][i] * forward + right[a][i] * side;
+			if (a == 1) {
+				v += vertical;
+			}
+			position[a][i] += v * velocity;
+		}
+	}
+}
+
+void SgTCameraPool::getViewMat(SgTmat4* const view) const {
+	const float* const position[3] = {
+		this->array[SgTCameraPool::POSITION_X], this->array[SgTCameraPool::POSITION_Y], this->array[SgTCameraPool::POSITION_Z]
+	};
+	//the rows of the rotation, which are right, up and -front
+	const float* const axis[3][3] = {
+		{ this->array[SgTCameraPool::RIGHT_X], this->array[SgTCameraPool::RIGHT_Y], this->array[SgTCameraPool::RIGHT_Z] },
+		{ this->array[SgTCameraPool::UP_X], this->array[SgTCameraPool::UP_Y], this->array[SgTCameraPool::UP_Z] },
+		{ this->array[SgTCameraPool::FRONT_X], this->array[SgTCameraPool::FRONT_Y], this->array[SgTCameraPool::FRONT_Z] }
+	};
+	//the sign of each row
+	const float sign[3] = { 1.0f, 1.0f, -1.0f };
+
+	//the translation is -dot(axis, position) for each row
+	alignas(32) float translation[3][8];
+	for (size_t i = 0; i < this->count; i += 8u) {
+#if defined(SgT_SIMD_AVX)
+		const __m256 px = _mm256_load_ps(position[0] + i), py = _mm256_load_ps(position[1] + i), pz = _mm256_load_ps(position[2] + i);
+		for (int r = 0; r < 3; r++) {
+			__m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(axis[r][0] + i), px), _mm256_mul_ps(_mm256_load_ps(axis[r][1] + i), py));
+			d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_load_ps(axis[r][2] + i), pz));
+			_mm256_store_ps(translation[r], _mm256_mul_ps(d, _mm256_set1_ps(-sign[r])));
+		}
+#else
+		for (int r = 0; r < 3; r++) {
+			for (size_t l = 0; l < 8u; l++) {
+				translation[r][l] = -sign[r] * (axis[r][0][i + l] * position[0][i + l] + axis[r][1][i + l] * position[1][i + l]
+					+ axis[r][2][i + l] * position[2][i + l]);
+			}
+		}
+#endif
+
+		//scatter the lanes into column-major matrices
+		const size_t end = std::min(this->count - i, static_cast<size_t>(8u));
+		for (size_t l = 0; l < end; l++) {
+			const size_t c = i + l;
+			SgTmat4& m = view[c];
+			for (int col = 0; col < 3; col++) {
+				m[col] = SgTvec4(axis[0][col][c], axis[1][col][c], -axis[2][col][c], 0.0f);
+			}
+			m[3] = SgTvec4(translation[0][l], translation[1][l], translation[2][l], 1.0f);
+		}
+	}
+}
\ No newline at end of file
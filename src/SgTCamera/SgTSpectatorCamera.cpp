@@ -4,13 +4,23 @@ using namespace SglToolkit;
 
 SgTSpectatorCamera::SgTSpectatorCamera(const float yaw, const float pitch, const float movementSpeed,
 	const float mouseSens, const float zoom, const SgTvec3 position, const SgTvec3 up, const SgTvec3 front)
-	: SgTCamera(yaw, pitch, movementSpeed, mouseSens, zoom, position, up, front) {
+	: SgTCamera(yaw, pitch, movementSpeed, mouseSens, zoom, position, up, front), input(nullptr), heldMask(0u) {
 	//initialse values
 	this->calcCameraVector();
 }
 
 SgTSpectatorCamera::~SgTSpectatorCamera() {
+	delete this->input.load(std::memory_order_acquire);
+}
 
+const bool SgTSpectatorCamera::postInput(const SgTCameraInput& event) {
+	SgTInputQueue* queue = this->input.load(std::memory_order_relaxed);
+	if (queue == nullptr) {
+		//only the window thread allocates, the update thread sees the queue once it is stored
+		queue = new SgTInputQueue();
+		this->input.store(queue, std::memory_order_release);
+	}
+	return queue->push(event);
 }
 
 void SgTSpectatorCamera::calcCameraVector() {
@@ -28,6 +38,13 @@ void SgTSpectatorCamera::calcCameraVector() {
 }
 
 void SgTSpectatorCamera::procMouseMov(float Xoffset, float Yoffset, const bool limitPitch = true) {
+	this->procMouseAngle(Xoffset, Yoffset, limitPitch);
+	//update the front, right and up
+	this->calcCameraVector();
+	this->markDirty();
+}
+
+void SgTSpectatorCamera::procMouseAngle(float Xoffset, float Yoffset, const bool limitPitch) {
 	//using sensitivity to scale the offsets
 	Xoffset *= this->MouseSensitivity;
 	Yoffset *= this->MouseSensitivity;
@@ -50,9 +67,33 @@ void SgTSpectatorCamera::procMouseMov(float Xoffset, float Yoffset, const bool l
 			this->Pitch = -89.0f;
 		}
 	}
+}
 
-	//update the front, right and up
-	this->calcCameraVector();
+const SgTvec2 SgTSpectatorCamera::procCursor(const float Xpos, const float Ypos) {
+	//The first time the cursor is seen, last position will be initialised
+	if (this->firstMouse) {
+		this->lastX = Xpos;
+		this->lastY = Ypos;
+		this->firstMouse = false;
+	}
+	//we reverse Y since Y goes from bottom to top (from negative axis to positive)
+	const SgTvec2 offset = SgTvec2(Xpos - this->lastX, this->lastY - Ypos);
+	//update the last position
+	this->lastX = Xpos;
+	this->lastY = Ypos;
+	return offset;
+}
+
+void SgTSpectatorCamera::procScroll(const float Yoffset, const SgTRange limitZoom) {
+	//we only need the y axis, and the y is counted from negative to positive so we use minus.
+	this->Zoom -= Yoffset;
+	//limit the zoom
+	if (this->Zoom < limitZoom.min) {
+		this->Zoom = limitZoom.min;
+	}
+	if (this->Zoom > limitZoom.max) {
+		this->Zoom = limitZoom.max;
+	}
 }
 
 void SgTSpectatorCamera::keyUpdate(const SgTCameraMovement direction, const float deltaTime) {
@@ -74,30 +115,99 @@ void SgTSpectatorCamera::keyUpdate(const SgTCameraMovement direction, const floa
 	case SgTSpectatorCamera::DOWN: this->Position -= SgTCamera::WORLD_UP * velocity;
 		break;
 	default:
-		break;
+		return;
 	}
+	this->markDirty();
 }
 
 void SgTSpectatorCamera::mouseUpdate(const float Xpos, const float Ypos, const bool limitPitch) {
-	//The first time the programe runs, last position will be initialised
-	static float lastX = Xpos;
-	static float lastY = Ypos;
-
-	//we reverse Y since Y goes from bottom to top (from negative axis to positive)
-	this->procMouseMov(Xpos - lastX, lastY - Ypos, limitPitch);
-	//update the last position
-	lastX = Xpos;
-	lastY = Ypos;
+	const SgTvec2 offset = this->procCursor(Xpos, Ypos);
+	this->procMouseMov(offset.x, offset.y, limitPitch);
 }
 
 void SgTSpectatorCamera::scrollUpdate(const float Yoffset, const SgTRange limitZoom) {
-	//we only need the y axis, and the y is counted from negative to positive so we use minus.
-	this->Zoom -= Yoffset;
-	//limit the zoom
-	if (this->Zoom < limitZoom.min) {
-		this->Zoom = limitZoom.min;
+	this->procScroll(Yoffset, limitZoom);
+	this->markDirty();
+}
+
+const bool SgTSpectatorCamera::postKey(const SgTCameraMovement direction, const bool pressed) {
+	const unsigned int bit = SgTSpectatorCamera::getMovementBit(direction);
+	if (bit == 0u) {
+		return false;
 	}
-	if (this->Zoom > limitZoom.max) {
-		this->Zoom = limitZoom.max;
+	if (pressed) {
+		this->heldMask.fetch_or(bit, std::memory_order_relaxed);
+	}
+	else {
+		this->heldMask.fetch_and(~bit, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+const bool SgTSpectatorCamera::postMouse(const float Xpos, const float Ypos) {
+	SgTCameraInput event;
+	event.type = SgTCameraInput::SgTInputType::MOUSE;
+	event.x = Xpos;
+	event.y = Ypos;
+	return this->postInput(event);
+}
+
+const bool SgTSpectatorCamera::postScroll(const float Yoffset) {
+	SgTCameraInput event;
+	event.type = SgTCameraInput::SgTInputType::SCROLL;
+	event.x = 0.0f;
+	event.y = Yoffset;
+	return this->postInput(event);
+}
+
+void SgTSpectatorCamera::processInput(const float deltaTime, const bool limitPitch, const SgTRange limitZoom) {
+	//sum up everything posted since the last frame
+	SgTvec2 mouseOffset = SgTvec2(0.0f, 0.0f);
+	float scrollOffset = 0.0f;
+	bool mouse = false, scroll = false;
+	SgTCameraInput event;
+	SgTInputQueue* const queue = this->input.load(std::memory_order_acquire);
+	while (queue != nullptr && queue->pop(event)) {
+		switch (event.type) {
+		case SgTCameraInput::SgTInputType::MOUSE:
+			mouseOffset += this->procCursor(event.x, event.y);
+			mouse = true;
+			break;
+		case SgTCameraInput::SgTInputType::SCROLL:
+			scrollOffset += event.y;
+			scroll = true;
+			break;
+		default:
+			break;
+		}
+	}
+
+	//only the latest key state matters
+	this->movementMask = this->heldMask.load(std::memory_order_relaxed);
+
+	bool changed = false;
+	if (mouse) {
+		this->procMouseAngle(mouseOffset.x, mouseOffset.y, limitPitch);
+		//the camera vectors are resolved once per frame
+		this->calcCameraVector();
+		changed = true;
+	}
+	if (this->movementMask != 0u) {
+		const unsigned int mask = this->movementMask;
+		const auto held = [mask](const SgTCameraMovement direction) {
+			return (mask & SgTSpectatorCamera::getMovementBit(direction)) != 0u ? 1.0f : 0.0f;
+		};
+		const SgTvec3 move = this->Front * (held(SgTSpectatorCamera::FORWARD) - held(SgTSpectatorCamera::BACKWARD))
+			+ this->Right * (held(SgTSpectatorCamera::RIGHT) - held(SgTSpectatorCamera::LEFT))
+			+ SgTCamera::WORLD_UP * (held(SgTSpectatorCamera::UP) - held(SgTSpectatorCamera::DOWN));
+		this->Position += move * (this->MovementSpeed * deltaTime);
+		changed = true;
+	}
+	if (scroll) {
+		this->procScroll(scrollOffset, limitZoom);
+		changed = true;
+	}
+	if (changed) {
+		this->markDirty();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "SgTCascadedShadowBox.h"
+
+#include <cmath>
+
+using namespace SglToolkit;
+
+SgTCascadedShadowBox::SgTCascadedShadowBox(SgTCamera* const camera, const SgTvec3 lightDir, const float nearPlane, const float aspect,
+	const unsigned int cascadeCount, const unsigned int resolution) : SgTShadowBox(camera, lightDir, nearPlane, aspect), CascadeCount(cascadeCount), Resolution(resolution) {
+	if (this->CascadeCount == 0u || this->CascadeCount > SgTCascadedShadowBox::MAX_CASCADE) {
+		throw "InvalidCascadeCountException";
+	}
+	this->calcPracticalSplit();
+	this->block = SgTCascadeBlock();
+	this->block.count = static_cast<GLint>(this->CascadeCount);
+}
+
+SgTCascadedShadowBox::~SgTCascadedShadowBox() {
+
+}
+
+void SgTCascadedShadowBox::calcPracticalSplit() {
+	const float n = this->NEAR_PLANE, f = this->SHADOW_DISTANCE;
+	this->splitDistance[0] = n;
+	for (unsigned int i = 1u; i < this->CascadeCount; i++) {
+		const float ratio = static_cast<float>(i) / static_cast<float>(this->CascadeCount);
+		//logarithmic split keeps the texel density uniform in screen space, uniform split avoids too thin cascades near the camera
+		const float logSplit = n * std::pow(f / n, ratio);
+		const float uniformSplit = n + (f - n) * ratio;
+		this->splitDistance[i] = this->splitLambda * logSplit + (1.0f - this->splitLambda) * uniformSplit;
+	}
+	this->splitDistance[this->CascadeCount] = f;
+}
+
+void SgTCascadedShadowBox::setPracticalSplit(const float lambda) {
+	this->splitLambda = glm::clamp(lambda, 0.0f, 1.0f);
+	this->calcPracticalSplit();
+	this->invalidate();
+}
+
+void SgTCascadedShadowBox::setSplit(const float* const distance) {
+	float last = this->NEAR_PLANE;
+	for (unsigned int i = 0u; i < this->CascadeCount; i++) {
+		if (!(distance[i] > last)) {
+			throw "InvalidSplitException";
+		}
+		last = distance[i];
+	}
+	this->splitLambda = -1.0f;
+	this->splitDistance[0] = this->NEAR_PLANE;
+	for (unsigned int i = 0u; i < this->CascadeCount; i++) {
+		this->splitDistance[i + 1u] = distance[i];
+	}
+	this->SHADOW_DISTANCE = last;
+	this->invalidate();
+}
+
+void SgTCascadedShadowBox::checkSplit() const {
+	if (this->splitLambda >= 0.0f) {
+		return;
+	}
+	//an inverted first cascade, or a base box that no longer covers the same distance as the cascades
+	if (!(this->NEAR_PLANE < this->splitDistance[1]) || this->SHADOW_DISTANCE != this->splitDistance[this->CascadeCount]) {
+		throw "InvalidSplitException";
+	}
+}
+
+void SgTCascadedShadowBox::update(const float aspect) {
+	//checked before anything is fitted, so the box is left as it was
+	this->checkSplit();
+	SgTShadowBox::update(aspect);
+	//the cascades are fitted from the same state as the whole box
+	if (!this->isShadowValid()) {
+		this->fitCascade(aspect);
+	}
+}
+
+void SgTCascadedShadowBox::copyBounds(const SgTShadowBox& box, const float aspect) {
+	this->checkSplit();
+	SgTShadowBox::copyBounds(box, aspect);
+	//cascades depend on the light, so they are always fitted
+	this->fitCascade(aspect);
+}
+
+void SgTCascadedShadowBox::fitCascade(const float aspect) {
+	if (this->splitLambda >= 0.0f) {
+		this->calcPracticalSplit();
+	}
+	else {
+		this->splitDistance[0] = this->NEAR_PLANE;
+	}
+
+	//camera basis, same as the whole shadow box
+	const SgTmat4 rotation = this->getCameraRotation();
+	const SgTvec3 forward = SgTvec3(rotation * this->FORWARD);
+	const SgTvec3 up = SgTvec3(rotation * this->UP);
+	const SgTvec3 right = glm::cross(forward, up);
+	const SgTvec3 position = this->Camera->getPosition();
+	//the size of the frustum grows linearly with the distance, as in calcViewFrustumPlanes()
+	const float widthScale = static_cast<float>(glm::tan(glm::radians(this->Camera->getZoomDeg())));
+
+	//every split plane is computed once, and shared by the two cascades it separates
+	SgTvec3 planeCorner[SgTCascadedShadowBox::MAX_CASCADE + 1][4];
+	for (unsigned int p = 0u; p <= this->CascadeCount; p++) {
+		const float distance = this->splitDistance[p];
+		const SgTvec3 center = position + forward * distance;
+		const SgTvec3 width = right * (distance * widthScale);
+		const SgTvec3 height = up * (distance * widthScale / aspect);
+		planeCorner[p][0] = center + height + width;
+		planeCorner[p][1] = center + height - width;
+		planeCorner[p][2] = center - height + width;
+		planeCorner[p][3] = center - height - width;
+	}
+
+	//the light view is rotation only, so snapping in light space is the same for every cascade
+	this->cascadeView = this->lightView;
+
+	for (unsigned int i = 0u; i < this->CascadeCount; i++) {
+		//bounding sphere of the slice, it does not change with the camera rotation
+		SgTvec3 center = SgTvec3(0.0f, 0.0f, 0.0f);
+		for (int c = 0; c < 4; c++) {
+			center += planeCorner[i][c] + planeCorner[i + 1u][c];
+		}
+		center = center / 8.0f;
+		float radius = 0.0f;
+		for (int c = 0; c < 4; c++) {
+			radius = glm::max(radius, glm::max(glm::distance(center, planeCorner[i][c]), glm::distance(center, planeCorner[i + 1u][c])));
+		}
+		//quantise the radius so floating point error does not change the projection size between frames
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		//snap the center to whole texels in light space
+		const float texel = 2.0f * radius / static_cast<float>(this->Resolution);
+		SgTvec4 lightCenter = this->cascadeView * SgTvec4(center, 1.0f);
+		lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+		lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+
+		//the box is extended towards the light by OFFSET, so casters outside the view still cast into it
+		const float nearDepth = -lightCenter.z - radius - this->OFFSET;
+		const float farDepth = -lightCenter.z + radius;
+		this->cascadeProjection[i] = glm::ortho(lightCenter.x - radius, lightCenter.x + radius, lightCenter.y - radius, lightCenter.y + radius, nearDepth, farDepth);
+
+		this->block.lightViewProjection[i] = this->cascadeProjection[i] * this->cascadeView;
+		this->block.split[i] = SgTvec4(this->splitDistance[i], this->splitDistance[i + 1u], texel, farDepth - nearDepth);
+	}
+	this->block.count = static_cast<GLint>(this->CascadeCount);
+}
\ No newline at end of file
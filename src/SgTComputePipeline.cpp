@@ -0,0 +1,136 @@
+#include "SgTComputePipeline.h"
+
+#include <array>
+
+using namespace SglToolkit;
+
+SgTComputePipeline::SgTComputePipeline() {
+
+}
+
+SgTComputePipeline::~SgTComputePipeline() {
+
+}
+
+const GLint* const SgTComputePipeline::getWorkGroupSize(const SgTShaderProc& program) {
+	const GLint* const size = program.getReflection().getWorkGroupSize();
+	if (size[0] <= 0) {
+		throw "NotComputeProgramException";
+	}
+	return size;
+}
+
+void SgTComputePipeline::getGroupCount(const SgTShaderProc& program, const GLuint* const element, GLuint* const group) {
+	//limit of the driver does not change, only query it once
+	static const std::array<GLint, 3> maxCount = []() {
+		std::array<GLint, 3> count;
+		for (GLuint i = 0u; i < 3u; i++) {
+			glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, i, &count[i]);
+		}
+		return count;
+	}();
+
+	const GLint* const size = SgTComputePipeline::getWorkGroupSize(program);
+	for (int i = 0; i < 3; i++) {
+		const GLuint local = static_cast<GLuint>(size[i]);
+		group[i] = element[i] / local + (element[i] % local != 0u ? 1u : 0u);
+		if (group[i] > static_cast<GLuint>(maxCount[i])) {
+			throw "WorkGroupCountExceededException";
+		}
+	}
+}
+
+const GLbitfield SgTComputePipeline::resolveHazard(const SgTResourceAccess* const access, const size_t count) {
+	//read-after-write and write-after-write must wait until the earlier write is visible to this kind of access
+	GLbitfield barrier = 0u;
+	for (size_t i = 0; i < count; i++) {
+		const auto it = this->hazard.find(access[i].resource);
+		if (it != this->hazard.end()) {
+			barrier |= access[i].usage & ~it->second;
+		}
+	}
+	//a barrier makes every earlier write visible, not only the one that requires it
+	if (barrier != 0u) {
+		for (auto& h : this->hazard) {
+			h.second |= barrier;
+		}
+	}
+	//writes of this dispatch are not visible to anything yet
+	for (size_t i = 0; i < count; i++) {
+		if ((access[i].access & SgTComputePipeline::WRITE) != 0u) {
+			this->hazard[access[i].resource] = 0u;
+		}
+	}
+	return barrier;
+}
+
+void SgTComputePipeline::addDispatch(const SgTShaderProc& program, const GLuint* const group, const SgTResourceAccess* const access, const size_t count, SgTProgramPara arg) {
+	SgTComputePipeline::getWorkGroupSize(program);
+	this->dispatch.push_back(SgTDispatch{
+		&program, { group[0], group[1], group[2] }, 0u, 0, arg, this->resolveHazard(access, count)
+	});
+}
+
+void SgTComputePipeline::addDispatchElement(const SgTShaderProc& program, const GLuint* const element, const SgTResourceAccess* const access, const size_t count, SgTProgramPara arg) {
+	GLuint group[3];
+	SgTComputePipeline::getGroupCount(program, element, group);
+	this->addDispatch(program, group, access, count, arg);
+}
+
+void SgTComputePipeline::addDispatchIndirect(const SgTShaderProc& program, const GLuint buffer, const GLintptr offset, const SgTResourceAccess* const access, const size_t count, SgTProgramPara arg) {
+	SgTComputePipeline::getWorkGroupSize(program);
+	//the dispatch command itself reads the indirect buffer
+	std::vector<SgTResourceAccess> allAccess(access, access + count);
+	allAccess.push_back(SgTResourceAccess{ buffer, SgTComputePipeline::READ, GL_COMMAND_BARRIER_BIT });
+	this->dispatch.push_back(SgTDispatch{
+		&program, { 0u, 0u, 0u }, buffer, offset, arg, this->resolveHazard(allAccess.data(), allAccess.size())
+	});
+}
+
+void SgTComputePipeline::addConsumer(const SgTResourceAccess* const access, const size_t count) {
+	const GLbitfield barrier = this->resolveHazard(access, count);
+	if (barrier != 0u) {
+		this->dispatch.push_back(SgTDispatch{ nullptr, { 0u, 0u, 0u }, 0u, 0, NULL, barrier });
+	}
+}
+
+void SgTComputePipeline::submit() {
+	GLuint currentProgram = 0u;
+	for (const SgTDispatch& d : this->dispatch) {
+		if (d.barrier != 0u) {
+			glMemoryBarrier(d.barrier);
+		}
+		if (d.program == nullptr) {
+			continue;
+		}
+
+		const GLuint program = d.program->getP();
+		//consecutive dispatches of the same program do not rebind it
+		if (program != currentProgram) {
+			glUseProgram(program);
+			currentProgram = program;
+		}
+		if (d.arg != NULL) {
+			(*d.arg)(program);
+		}
+		if (d.indirectBuffer != 0u) {
+			glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, d.indirectBuffer);
+			glDispatchComputeIndirect(d.indirectOffset);
+		}
+		else {
+			glDispatchCompute(d.groupCount[0], d.groupCount[1], d.groupCount[2]);
+		}
+	}
+	this->dispatch.clear();
+	this->submittedHazard = this->hazard;
+}
+
+void SgTComputePipeline::clear() {
+	this->dispatch.clear();
+	this->hazard = this->submittedHazard;
+}
+
+void SgTComputePipeline::resetHazard() {
+	this->hazard.clear();
+	this->submittedHazard.clear();
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "SgTCubeShadowBox.h"
+#include "SgTSIMD.h"
+
+#include <cstring>
+
+using namespace SglToolkit;
+
+SgTCubeShadowBox::SgTCubeShadowBox(const SgTvec3 position, const float nearPlane, const float farPlane) : Position(position) {
+	this->setDepthRange(nearPlane, farPlane);
+	this->update();
+}
+
+SgTCubeShadowBox::~SgTCubeShadowBox() {
+
+}
+
+void SgTCubeShadowBox::calcBase() {
+	//the direction and up vector of each face, as defined by the cube map
+	static const SgTvec3 direction[SgTCubeShadowBox::FACE_COUNT] = {
+		SgTvec3(1.0f, 0.0f, 0.0f), SgTvec3(-1.0f, 0.0f, 0.0f), SgTvec3(0.0f, 1.0f, 0.0f),
+		SgTvec3(0.0f, -1.0f, 0.0f), SgTvec3(0.0f, 0.0f, 1.0f), SgTvec3(0.0f, 0.0f, -1.0f)
+	};
+	static const SgTvec3 up[SgTCubeShadowBox::FACE_COUNT] = {
+		SgTvec3(0.0f, -1.0f, 0.0f), SgTvec3(0.0f, -1.0f, 0.0f), SgTvec3(0.0f, 0.0f, 1.0f),
+		SgTvec3(0.0f, 0.0f, -1.0f), SgTvec3(0.0f, -1.0f, 0.0f), SgTvec3(0.0f, -1.0f, 0.0f)
+	};
+
+	this->projection = glm::perspective(glm::radians(90.0f), 1.0f, this->NearPlane, this->FarPlane);
+	const SgTvec3 origin = SgTvec3(0.0f, 0.0f, 0.0f);
+	for (unsigned int f = 0u; f < SgTCubeShadowBox::FACE_COUNT; f++) {
+		const SgTmat4 viewProjection = this->projection * glm::lookAt(origin, direction[f], up[f]);
+		for (int c = 0; c < 4; c++) {
+			for (int r = 0; r < 4; r++) {
+				this->base[c][f * 4u + r] = viewProjection[c][r];
+			}
+		}
+	}
+}
+
+void SgTCubeShadowBox::setPosition(const SgTvec3 position) {
+	this->Position = position;
+}
+
+void SgTCubeShadowBox::setDepthRange(const float nearPlane, const float farPlane) {
+	if (!(nearPlane > 0.0f) || !(farPlane > nearPlane)) {
+		throw "InvalidDepthRangeException";
+	}
+	this->NearPlane = nearPlane;
+	this->FarPlane = farPlane;
+	this->calcBase();
+}
+
+void SgTCubeShadowBox::update() {
+	//moving the light only changes the translation column, which is (M * -position + last column) of the light at the origin
+	constexpr unsigned int length = SgTCubeShadowBox::FACE_COUNT * 4u;
+	alignas(32) float translation[length];
+	const float px = -this->Position.x, py = -this->Position.y, pz = -this->Position.z;
+#if defined(SgT_SIMD_AVX)
+	const __m256 x = _mm256_set1_ps(px), y = _mm256_set1_ps(py), z = _mm256_set1_ps(pz);
+	for (unsigned int i = 0u; i < length; i += 8u) {
+		__m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(this->base[0] + i), x), _mm256_mul_ps(_mm256_load_ps(this->base[1] + i), y));
+		v = _mm256_add_ps(v, _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(this->base[2] + i), z), _mm256_load_ps(this->base[3] + i)));
+		_mm256_store_ps(translation + i, v);
+	}
+#elif defined(SgT_SIMD_SSE)
+	const __m128 x = _mm_set1_ps(px), y = _mm_set1_ps(py), z = _mm_set1_ps(pz);
+	for (unsigned int i = 0u; i < length; i += 4u) {
+		__m128 v = _mm_add_ps(_mm_mul_ps(_mm_load_ps(this->base[0] + i), x), _mm_mul_ps(_mm_load_ps(this->base[1] + i), y));
+		v = _mm_add_ps(v, _mm_add_ps(_mm_mul_ps(_mm_load_ps(this->base[2] + i), z), _mm_load_ps(this->base[3] + i)));
+		_mm_store_ps(translation + i, v);
+	}
+#else
+	for (unsigned int i = 0u; i < length; i++) {
+		translation[i] = this->base[0][i] * px + this->base[1][i] * py + this->base[2][i] * pz + this->base[3][i];
+	}
+#endif
+
+	//the other columns do not change
+	for (unsigned int f = 0u; f < SgTCubeShadowBox::FACE_COUNT; f++) {
+		SgTmat4& m = this->faceViewProjection[f];
+		for (int c = 0; c < 3; c++) {
+			std::memcpy(&m[c][0], this->base[c] + f * 4u, sizeof(float) * 4);
+		}
+		std::memcpy(&m[3][0], translation + f * 4u, sizeof(float) * 4);
+	}
+}
+
+void SgTCubeShadowBox::cullFace(const SgTvec3* const min, const SgTvec3* const max, const size_t count, unsigned char* const mask) const {
+	const float range = this->FarPlane * this->FarPlane;
+	for (size_t i = 0; i < count; i++) {
+		//the bounding box relative to the light
+		const SgTvec3 lo = min[i] - this->Position;
+		const SgTvec3 hi = max[i] - this->Position;
+
+		//the closest point of the box to the light
+		const SgTvec3 closest = glm::max(glm::min(SgTvec3(0.0f, 0.0f, 0.0f), hi), lo);
+		if (glm::dot(closest, closest) > range) {
+			mask[i] = 0u;
+			continue;
+		}
+
+		//the smallest absolute coordinate on each axis over the box, which is 0 if the box crosses the axis plane
+		const SgTvec3 inner = glm::max(glm::max(lo, -hi), SgTvec3(0.0f));
+		//a face along +x contains the points with x >= |y| and x >= |z|, the box touches it if its furthest x reaches the nearest |y| and |z|
+		const float reach[SgTCubeShadowBox::FACE_COUNT] = { hi.x, -lo.x, hi.y, -lo.y, hi.z, -lo.z };
+		const float other[3][2] = { { inner.y, inner.z }, { inner.x, inner.z }, { inner.x, inner.y } };
+		unsigned char faces = 0u;
+		for (unsigned int f = 0u; f < SgTCubeShadowBox::FACE_COUNT; f++) {
+			const float* const o = other[f >> 1u];
+			faces |= static_cast<unsigned char>((reach[f] >= o[0] && reach[f] >= o[1]) ? 1u << f : 0u);
+		}
+		mask[i] = faces;
+	}
+}
\ No newline at end of file
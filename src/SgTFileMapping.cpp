@@ -0,0 +1,110 @@
+#include "SgTFileMapping.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace SglToolkit;
+
+SgTFileMapping::SgTFileMapping() {
+
+}
+
+SgTFileMapping::SgTFileMapping(const SgTstring path) {
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw "FileNotFoundException";
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw "FileMappingException";
+	}
+	this->length = static_cast<size_t>(size.QuadPart);
+	if (this->length > 0) {
+		//mapping object keeps the file alive, so file handle can be closed straight away
+		const HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(file);
+		if (mapping == NULL) {
+			throw "FileMappingException";
+		}
+		this->address = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (this->address == nullptr) {
+			CloseHandle(mapping);
+			throw "FileMappingException";
+		}
+		this->mappingHandle = mapping;
+	}
+	else {
+		CloseHandle(file);
+	}
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file == -1) {
+		throw "FileNotFoundException";
+	}
+	struct stat info;
+	if (fstat(file, &info) == -1) {
+		close(file);
+		throw "FileMappingException";
+	}
+	this->length = static_cast<size_t>(info.st_size);
+	if (this->length > 0) {
+		void* const mapped = mmap(NULL, this->length, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapped == MAP_FAILED) {
+			close(file);
+			throw "FileMappingException";
+		}
+		//the whole file is going to be read once, sequentially
+		madvise(mapped, this->length, MADV_SEQUENTIAL);
+		this->address = static_cast<const char*>(mapped);
+	}
+	close(file);
+#endif
+}
+
+SgTFileMapping::SgTFileMapping(SgTFileMapping&& mapping) noexcept {
+	*this = std::move(mapping);
+}
+
+SgTFileMapping& SgTFileMapping::operator=(SgTFileMapping&& mapping) noexcept {
+	if (this != &mapping) {
+		this->unmap();
+		this->address = mapping.address;
+		this->length = mapping.length;
+		mapping.address = nullptr;
+		mapping.length = 0;
+#ifdef _WIN32
+		this->mappingHandle = mapping.mappingHandle;
+		mapping.mappingHandle = nullptr;
+#endif
+	}
+	return *this;
+}
+
+SgTFileMapping::~SgTFileMapping() {
+	this->unmap();
+}
+
+void SgTFileMapping::unmap() {
+	if (this->address == nullptr) {
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(this->address);
+	CloseHandle(static_cast<HANDLE>(this->mappingHandle));
+	this->mappingHandle = nullptr;
+#else
+	munmap(const_cast<char*>(this->address), this->length);
+#endif
+	this->address = nullptr;
+	this->length = 0;
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "SgTFrustumCuller.h"
+#include "SgTSIMD.h"
+
+#include <cfloat>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace SglToolkit;
+
+namespace {
+	//The rows of the plane coefficients
+	constexpr int A = 0, B = 1, C = 2, D = 3, ABS_A = 4, ABS_B = 5, ABS_C = 6;
+
+	/**
+	 * @brief Cull a range of bounding volumes, an object is rejected by a plane if a.x + b.y + c.z + d < -reach at its center,
+	 * where the reach is the radius of a sphere or the extent of a box projected onto the plane normal
+	 * @tparam Box True if the source is a box array, otherwise a sphere array
+	 * @param coefficient - The plane coefficients
+	 * @param source - The arrays of the volumes, in the order of the members of SgTSphereArray or SgTBoxArray
+	 * @param begin - The first object
+	 * @param end - One past the last object
+	 * @param cache - The plane cache, or nullptr
+	 * @param index - The index of the visible objects
+	 * @return The number of visible object
+	*/
+	template<bool Box>
+	const size_t cullRange(const float(&coefficient)[7][8], const float* const* const source, const size_t begin, const size_t end,
+		unsigned char* const cache, unsigned int* const index) {
+		size_t visible = 0, i = begin;
+#if defined(SgT_SIMD_AVX)
+		const __m256 half = _mm256_set1_ps(0.5f), signMask = _mm256_set1_ps(-0.0f);
+		const __m256 noPlane = _mm256_set1_ps(static_cast<float>(SgTFrustumCuller::NO_PLANE));
+		const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1)), skip = _mm256_set1_ps(8.0f);
+		for (; i + 8u <= end; i += 8u) {
+			__m256 x, y, z, ex, ey, ez, radius;
+			if constexpr (Box) {
+				const __m256 minX = _mm256_loadu_ps(source[0] + i), minY = _mm256_loadu_ps(source[1] + i), minZ = _mm256_loadu_ps(source[2] + i);
+				const __m256 maxX = _mm256_loadu_ps(source[3] + i), maxY = _mm256_loadu_ps(source[4] + i), maxZ = _mm256_loadu_ps(source[5] + i);
+				x = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+				y = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+				z = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+				ex = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+				ey = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+				ez = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+			}
+			else {
+				x = _mm256_loadu_ps(source[0] + i);
+				y = _mm256_loadu_ps(source[1] + i);
+				z = _mm256_loadu_ps(source[2] + i);
+				radius = _mm256_loadu_ps(source[3] + i);
+			}
+			//the negative reach of the volume against a plane, given the plane coefficients of each lane
+			const auto reach = [&](const __m256 absA, const __m256 absB, const __m256 absC) {
+				if constexpr (Box) {
+					return _mm256_xor_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(absA, ex), _mm256_mul_ps(absB, ey)), _mm256_mul_ps(absC, ez)), signMask);
+				}
+				else {
+					return _mm256_xor_ps(radius, signMask);
+				}
+			};
+			const auto distance = [&](const __m256 a, const __m256 b, const __m256 c, const __m256 d) {
+				return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), _mm256_add_ps(_mm256_mul_ps(c, z), d));
+			};
+
+			if (cache) {
+				//test the plane of each lane that rejected it last time, the lanes after the planes never reject anything
+#if defined(SgT_SIMD_AVX2)
+				const __m256i p = _mm256_and_si256(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cache + i))), _mm256_set1_epi32(7));
+				const auto gather = [&p, &coefficient](const int row) {
+					return _mm256_permutevar8x32_ps(_mm256_load_ps(coefficient[row]), p);
+				};
+#else
+				//no lane permute without AVX2, pick each coefficient from memory
+				unsigned int p[8];
+				for (int l = 0; l < 8; l++) {
+					p[l] = cache[i + l] & 7u;
+				}
+				const auto gather = [&p, &coefficient](const int row) {
+					const float* const c = coefficient[row];
+					return _mm256_setr_ps(c[p[0]], c[p[1]], c[p[2]], c[p[3]], c[p[4]], c[p[5]], c[p[6]], c[p[7]]);
+				};
+#endif
+				const __m256 dist = distance(gather(A), gather(B), gather(C), gather(D));
+				if (_mm256_movemask_ps(_mm256_cmp_ps(dist, reach(gather(ABS_A), gather(ABS_B), gather(ABS_C)), _CMP_LT_OQ)) == 0xFF) {
+					continue;
+				}
+			}
+
+			//test all planes, the plane recorded for a rejected lane is the first plane rejecting it.
+			//A plane that does not reject is pushed past NO_PLANE so the minimum picks it, which avoids a blend
+			__m256 inside = all, rejectPlane = noPlane;
+			for (int p = static_cast<int>(SgTFrustumCuller::PLANE_COUNT) - 1; p >= 0; p--) {
+				const __m256 dist = distance(_mm256_set1_ps(coefficient[A][p]), _mm256_set1_ps(coefficient[B][p]),
+					_mm256_set1_ps(coefficient[C][p]), _mm256_set1_ps(coefficient[D][p]));
+				const __m256 outside = _mm256_cmp_ps(dist, reach(_mm256_set1_ps(coefficient[ABS_A][p]), _mm256_set1_ps(coefficient[ABS_B][p]),
+					_mm256_set1_ps(coefficient[ABS_C][p])), _CMP_LT_OQ);
+				rejectPlane = _mm256_min_ps(rejectPlane, _mm256_add_ps(_mm256_set1_ps(static_cast<float>(p)), _mm256_andnot_ps(outside, skip)));
+				inside = _mm256_andnot_ps(outside, inside);
+			}
+			if (cache) {
+				alignas(32) float plane[8];
+				_mm256_store_ps(plane, rejectPlane);
+				for (int l = 0; l < 8; l++) {
+					cache[i + l] = static_cast<unsigned char>(plane[l]);
+				}
+			}
+
+			//compact the visible lanes without branching, the output never goes past the index of the current lane
+			const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(inside));
+			for (unsigned int l = 0u; l < 8u; l++) {
+				index[visible] = static_cast<unsigned int>(i + l);
+				visible += (mask >> l) & 1u;
+			}
+		}
+#elif defined(SgT_SIMD_SSE)
+		//the same as above 4 objects at a time, using SSE1 only
+		const __m128 half = _mm_set1_ps(0.5f), signMask = _mm_set1_ps(-0.0f);
+		const __m128 noPlane = _mm_set1_ps(static_cast<float>(SgTFrustumCuller::NO_PLANE));
+		const __m128 all = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps()), skip = _mm_set1_ps(8.0f);
+		for (; i + 4u <= end; i += 4u) {
+			__m128 x, y, z, ex, ey, ez, radius;
+			if constexpr (Box) {
+				const __m128 minX = _mm_loadu_ps(source[0] + i), minY = _mm_loadu_ps(source[1] + i), minZ = _mm_loadu_ps(source[2] + i);
+				const __m128 maxX = _mm_loadu_ps(source[3] + i), maxY = _mm_loadu_ps(source[4] + i), maxZ = _mm_loadu_ps(source[5] + i);
+				x = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+				y = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+				z = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+				ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+				ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+				ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+			}
+			else {
+				x = _mm_loadu_ps(source[0] + i);
+				y = _mm_loadu_ps(source[1] + i);
+				z = _mm_loadu_ps(source[2] + i);
+				radius = _mm_loadu_ps(source[3] + i);
+			}
+			const auto reach = [&](const __m128 absA, const __m128 absB, const __m128 absC) {
+				if constexpr (Box) {
+					return _mm_xor_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(absA, ex), _mm_mul_ps(absB, ey)), _mm_mul_ps(absC, ez)), signMask);
+				}
+				else {
+					return _mm_xor_ps(radius, signMask);
+				}
+			};
+			const auto distance = [&](const __m128 a, const __m128 b, const __m128 c, const __m128 d) {
+				return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), _mm_add_ps(_mm_mul_ps(c, z), d));
+			};
+
+			if (cache) {
+				unsigned int p[4];
+				for (int l = 0; l < 4; l++) {
+					p[l] = cache[i + l] & 7u;
+				}
+				const auto gather = [&p, &coefficient](const int row) {
+					const float* const c = coefficient[row];
+					return _mm_setr_ps(c[p[0]], c[p[1]], c[p[2]], c[p[3]]);
+				};
+				const __m128 dist = distance(gather(A), gather(B), gather(C), gather(D));
+				if (_mm_movemask_ps(_mm_cmplt_ps(dist, reach(gather(ABS_A), gather(ABS_B), gather(ABS_C)))) == 0xF) {
+					continue;
+				}
+			}
+
+			__m128 inside = all, rejectPlane = noPlane;
+			for (int p = static_cast<int>(SgTFrustumCuller::PLANE_COUNT) - 1; p >= 0; p--) {
+				const __m128 dist = distance(_mm_set1_ps(coefficient[A][p]), _mm_set1_ps(coefficient[B][p]),
+					_mm_set1_ps(coefficient[C][p]), _mm_set1_ps(coefficient[D][p]));
+				const __m128 outside = _mm_cmplt_ps(dist, reach(_mm_set1_ps(coefficient[ABS_A][p]), _mm_set1_ps(coefficient[ABS_B][p]),
+					_mm_set1_ps(coefficient[ABS_C][p])));
+				rejectPlane = _mm_min_ps(rejectPlane, _mm_add_ps(_mm_set1_ps(static_cast<float>(p)), _mm_andnot_ps(outside, skip)));
+				inside = _mm_andnot_ps(outside, inside);
+			}
+			if (cache) {
+				alignas(16) float plane[4];
+				_mm_store_ps(plane, rejectPlane);
+				for (int l = 0; l < 4; l++) {
+					cache[i + l] = static_cast<unsigned char>(plane[l]);
+				}
+			}
+
+			const unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(inside));
+			for (unsigned int l = 0u; l < 4u; l++) {
+				index[visible] = static_cast<unsigned int>(i + l);
+				visible += (mask >> l) & 1u;
+			}
+		}
+#endif
+
+		//the remaining objects
+		for (; i < end; i++) {
+			float x, y, z, ex = 0.0f, ey = 0.0f, ez = 0.0f, radius = 0.0f;
+			if constexpr (Box) {
+				x = (source[0][i] + source[3][i]) * 0.5f;
+				y = (source[1][i] + source[4][i]) * 0.5f;
+				z = (source[2][i] + source[5][i]) * 0.5f;
+				ex = (source[3][i] - source[0][i]) * 0.5f;
+				ey = (source[4][i] - source[1][i]) * 0.5f;
+				ez = (source[5][i] - source[2][i]) * 0.5f;
+			}
+			else {
+				x = source[0][i];
+				y = source[1][i];
+				z = source[2][i];
+				radius = source[3][i];
+			}
+			const auto outside = [&](const unsigned int p) {
+				const float reach = Box ? coefficient[ABS_A][p] * ex + coefficient[ABS_B][p] * ey + coefficient[ABS_C][p] * ez : radius;
+				return coefficient[A][p] * x + coefficient[B][p] * y + (coefficient[C][p] * z + coefficient[D][p]) < -reach;
+			};
+
+			if (cache && cache[i] < SgTFrustumCuller::PLANE_COUNT && outside(cache[i])) {
+				continue;
+			}
+			unsigned char rejectPlane = SgTFrustumCuller::NO_PLANE;
+			for (unsigned int p = 0u; p < SgTFrustumCuller::PLANE_COUNT; p++) {
+				if (outside(p)) {
+					rejectPlane = static_cast<unsigned char>(p);
+					break;
+				}
+			}
+			if (cache) {
+				cache[i] = rejectPlane;
+			}
+			if (rejectPlane == SgTFrustumCuller::NO_PLANE) {
+				index[visible++] = static_cast<unsigned int>(i);
+			}
+		}
+		return visible;
+	}
+}
+
+SgTFrustumCuller::SgTFrustumCuller() : THREAD_COUNT(std::max(std::thread::hardware_concurrency(), 1u)) {
+	this->setFrustum(SgTmat4(1.0f));
+}
+
+SgTFrustumCuller::~SgTFrustumCuller() {
+
+}
+
+void SgTFrustumCuller::setFrustum(const SgTmat4& matrix) {
+	//a point is inside the clip space if -w <= x, y, z <= w, each plane is the last row plus or minus another row of the matrix
+	SgTvec4 row[4];
+	for (int r = 0; r < 4; r++) {
+		row[r] = SgTvec4(matrix[0][r], matrix[1][r], matrix[2][r], matrix[3][r]);
+	}
+	this->plane[0] = row[3] + row[2];
+	this->plane[1] = row[3] - row[2];
+	this->plane[2] = row[3] + row[0];
+	this->plane[3] = row[3] - row[0];
+	this->plane[4] = row[3] - row[1];
+	this->plane[5] = row[3] + row[1];
+
+	for (unsigned int p = 0u; p < SgTFrustumCuller::PLANE_COUNT; p++) {
+		SgTvec4& current = this->plane[p];
+		//the distance to a plane is only in world unit when the normal is unit
+		current = current / glm::length(SgTvec3(current));
+
+		this->coefficient[A][p] = current.x;
+		this->coefficient[B][p] = current.y;
+		this->coefficient[C][p] = current.z;
+		this->coefficient[D][p] = current.w;
+		this->coefficient[ABS_A][p] = glm::abs(current.x);
+		this->coefficient[ABS_B][p] = glm::abs(current.y);
+		this->coefficient[ABS_C][p] = glm::abs(current.z);
+	}
+	for (unsigned int p = SgTFrustumCuller::PLANE_COUNT; p < 8u; p++) {
+		for (int r = 0; r < 7; r++) {
+			this->coefficient[r][p] = 0.0f;
+		}
+		this->coefficient[D][p] = FLT_MAX;
+	}
+}
+
+void SgTFrustumCuller::setFrustum(SgTCamera& camera) {
+	this->setFrustum(camera.getViewProjectionMat());
+}
+
+void SgTFrustumCuller::setFrustum(SgTShadowBox& shadowBox) {
+	this->setFrustum(shadowBox.getLightProjection() * shadowBox.getLightView());
+}
+
+const size_t SgTFrustumCuller::cullSphereRange(const SgTSphereArray& sphere, const size_t begin, const size_t end,
+	unsigned char* const cache, unsigned int* const index) const {
+	const float* const source[4] = { sphere.x, sphere.y, sphere.z, sphere.radius };
+	return cullRange<false>(this->coefficient, source, begin, end, cache, index);
+}
+
+const size_t SgTFrustumCuller::cullBoxRange(const SgTBoxArray& box, const size_t begin, const size_t end,
+	unsigned char* const cache, unsigned int* const index) const {
+	const float* const source[6] = { box.minX, box.minY, box.minZ, box.maxX, box.maxY, box.maxZ };
+	return cullRange<true>(this->coefficient, source, begin, end, cache, index);
+}
+
+const size_t SgTFrustumCuller::dispatch(const size_t count, unsigned int* const index,
+	const std::function<const size_t(const size_t, const size_t, unsigned int* const)>& range) const {
+	const size_t threadCount = std::min(static_cast<size_t>(std::max(this->THREAD_COUNT, 1u)), count / std::max(this->CHUNK_SIZE, static_cast<size_t>(1u)));
+	if (threadCount <= 1u) {
+		return range(0, count, index);
+	}
+
+	//chunks are multiples of 8 so only the last chunk has objects left over from the vector loop
+	const size_t chunk = ((count + threadCount - 1u) / threadCount + 7u) & ~static_cast<size_t>(7u);
+	std::vector<size_t> visible(threadCount, 0);
+	std::vector<std::thread> worker;
+	worker.reserve(threadCount - 1u);
+	//each chunk writes its visible index from the start of its own range in the output
+	for (size_t t = 1u; t < threadCount; t++) {
+		const size_t begin = t * chunk, end = std::min(begin + chunk, count);
+		if (begin >= end) {
+			break;
+		}
+		try {
+			worker.emplace_back([&range, &visible, index, t, begin, end]() {
+				visible[t] = range(begin, end, index + begin);
+			});
+		}
+		catch (const std::system_error&) {
+			//no more thread can be started, cull the chunk here instead
+			visible[t] = range(begin, end, index + begin);
+		}
+	}
+	visible[0] = range(0, std::min(chunk, count), index);
+	for (std::thread& w : worker) {
+		w.join();
+	}
+
+	//join the lists, each list starts at or after the end of the joined lists before it
+	size_t total = visible[0];
+	for (size_t t = 1u; t < threadCount; t++) {
+		if (visible[t] != 0u) {
+			std::memmove(index + total, index + t * chunk, sizeof(unsigned int) * visible[t]);
+			total += visible[t];
+		}
+	}
+	return total;
+}
+
+const size_t SgTFrustumCuller::cullSphere(const SgTSphereArray& sphere, const size_t count, unsigned int* const index, unsigned char* const cache) const {
+	return this->dispatch(count, index, [this, &sphere, cache](const size_t begin, const size_t end, unsigned int* const output) {
+		return this->cullSphereRange(sphere, begin, end, cache, output);
+	});
+}
+
+const size_t SgTFrustumCuller::cullBox(const SgTBoxArray& box, const size_t count, unsigned int* const index, unsigned char* const cache) const {
+	return this->dispatch(count, index, [this, &box, cache](const size_t begin, const size_t end, unsigned int* const output) {
+		return this->cullBoxRange(box, begin, end, cache, output);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "SgTMultiViewShadowBox.h"
+
+#include <cmath>
+
+using namespace SglToolkit;
+
+SgTMultiViewShadowBox::SgTMultiViewShadowBox(SgTCamera* const* const camera, const unsigned int count, const SgTvec3 lightDir, const float nearPlane, const float aspect)
+	: SgTShadowBox(SgTMultiViewShadowBox::getFirstView(camera, count), lightDir, nearPlane, aspect), ViewCount(count) {
+	for (unsigned int v = 0u; v < this->ViewCount; v++) {
+		this->View[v] = camera[v];
+	}
+}
+
+SgTMultiViewShadowBox::~SgTMultiViewShadowBox() {
+
+}
+
+SgTCamera* const SgTMultiViewShadowBox::getFirstView(SgTCamera* const* const camera, const unsigned int count) {
+	//checked before the shadow box is constructed with the first camera
+	if (count == 0u || count > SgTMultiViewShadowBox::MAX_VIEW) {
+		throw "InvalidViewCountException";
+	}
+	return camera[0];
+}
+
+const bool SgTMultiViewShadowBox::hasSameFrustum(const SgTShadowBox&) const {
+	//the union of several views is never the view frustum of another box
+	return false;
+}
+
+const bool SgTMultiViewShadowBox::reuseBounds(const float aspect) {
+	//the first camera and all settings are checked by the shadow box
+	if (!SgTShadowBox::reuseBounds(aspect)) {
+		return false;
+	}
+	const float tolerance = this->CACHE_TOLERANCE;
+	const auto near = [tolerance](const SgTvec3 a, const SgTvec3 b) {
+		const SgTvec3 d = glm::abs(a - b);
+		return d.x <= tolerance && d.y <= tolerance && d.z <= tolerance;
+	};
+	for (unsigned int v = 1u; v < this->ViewCount; v++) {
+		const SgTViewState& last = this->lastView[v];
+		SgTCamera* const camera = this->View[v];
+		if (!near(last.position, camera->getPosition()) || !near(last.front, camera->getFront()) || !near(last.up, camera->getUp())
+			|| std::fabs(last.zoom - camera->getZoomDeg()) > tolerance) {
+			this->shadowValid = false;
+			return false;
+		}
+	}
+	return true;
+}
+
+void SgTMultiViewShadowBox::update(const float aspect) {
+	if (this->reuseBounds(aspect)) {
+		return;
+	}
+
+	float unionMinX = 0.0f, unionMaxX = 0.0f, unionMinY = 0.0f, unionMaxY = 0.0f, unionMinZ = 0.0f, unionMaxZ = 0.0f;
+	float maxArea = 0.0f;
+	//the first view is done last, so the frustum of the shadow box is the frustum of its own camera
+	for (unsigned int i = this->ViewCount; i-- > 0u; ) {
+		SgTCamera* const camera = this->View[i];
+		this->calcCameraFrustum(camera, aspect, this->frustumCorner);
+		SgTShadowBox::calcFrustumPlane(this->frustumCorner, this->viewPlane + i * 6u);
+		this->boundLightSpace(this->frustumCorner);
+		maxArea = glm::max(maxArea, (this->maxX - this->minX) * (this->maxY - this->minY));
+
+		if (i == this->ViewCount - 1u) {
+			unionMinX = this->minX;
+			unionMaxX = this->maxX;
+			unionMinY = this->minY;
+			unionMaxY = this->maxY;
+			unionMinZ = this->minZ;
+			unionMaxZ = this->maxZ;
+		}
+		else {
+			unionMinX = glm::min(unionMinX, this->minX);
+			unionMaxX = glm::max(unionMaxX, this->maxX);
+			unionMinY = glm::min(unionMinY, this->minY);
+			unionMaxY = glm::max(unionMaxY, this->maxY);
+			unionMinZ = glm::min(unionMinZ, this->minZ);
+			unionMaxZ = glm::max(unionMaxZ, this->maxZ);
+		}
+
+		SgTViewState& last = this->lastView[i];
+		last.position = camera->getPosition();
+		last.front = camera->getFront();
+		last.up = camera->getUp();
+		last.zoom = camera->getZoomDeg();
+	}
+	for (int p = 0; p < 6; p++) {
+		this->frustumPlane[p] = this->viewPlane[p];
+	}
+
+	this->minX = unionMinX;
+	this->maxX = unionMaxX;
+	this->minY = unionMinY;
+	this->maxY = unionMaxY;
+	this->minZ = unionMinZ;
+	this->maxZ = unionMaxZ;
+	const float unionArea = (unionMaxX - unionMinX) * (unionMaxY - unionMinY);
+	this->shareRatio = maxArea > 0.0f ? unionArea / maxArea : 1.0f;
+
+	this->clipSceneBounds();
+	this->maxZ += this->OFFSET;
+	this->recordState(aspect);
+}
+
+const size_t SgTMultiViewShadowBox::cullCaster(const SgTvec3* const min, const SgTvec3* const max, const size_t count, unsigned int* const index) const {
+	return this->cullExtrusion(this->viewPlane, this->ViewCount, min, max, count, index);
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "SgTProgramCache.h"
+#include "SgTUtils.h"
+
+#include <filesystem>
+#include <vector>
+#include <cstdio>
+
+using namespace SglToolkit;
+
+namespace {
+	//The header that is written in front of every program binary
+	struct SgTCacheHeader {
+		unsigned int magic;
+		GLenum format;
+		SgTHash key;
+		unsigned long long length;
+	};
+}
+
+SgTProgramCache::SgTProgramCache(const SgTstring directory) : Directory(directory) {
+
+}
+
+SgTProgramCache::~SgTProgramCache() {
+
+}
+
+void SgTProgramCache::queryDriver() {
+	if (this->driverQueried) {
+		return;
+	}
+	//hash all strings that identify the driver, binaries are only valid for the exact same driver
+	SgTHash hash = SgTUtils::FNV_OFFSET;
+	for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		const char* const str = reinterpret_cast<const char*>(glGetString(name));
+		if (str != NULL) {
+			hash = SgTUtils::hashFNV(SgTstring(str), hash);
+		}
+		//separator such that ("ab", "c") and ("a", "bc") give different hash
+		hash = SgTUtils::hashCombine(hash, 0ull);
+	}
+	this->driverHash = hash;
+
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	this->binarySupported = formatCount > 0;
+	this->driverQueried = true;
+}
+
+const SgTstring SgTProgramCache::getCachePath(const SgTHash key) const {
+	char name[24];
+	std::snprintf(name, sizeof(name), "%016llx.sgtbin", key);
+
+	return (std::filesystem::path(this->Directory) / name).string();
+}
+
+const SgTHash SgTProgramCache::getDriverHash() {
+	this->queryDriver();
+	return this->driverHash;
+}
+
+const bool SgTProgramCache::loadProgram(const GLuint program, const SgTHash key) {
+	this->queryDriver();
+	if (!this->binarySupported) {
+		this->stat.miss++;
+		return false;
+	}
+
+	const SgTstring path = this->getCachePath(key);
+	std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+	if (!file.is_open()) {
+		this->stat.miss++;
+		return false;
+	}
+	//read the header and the binary
+	SgTCacheHeader header;
+	std::vector<char> binary;
+	std::error_code err;
+	const std::uintmax_t fileSize = std::filesystem::file_size(path, err);
+	bool valid = !err && fileSize >= sizeof(header)
+		&& static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		&& header.magic == SgTProgramCache::MAGIC && header.key == key
+		//the length is never trusted before it is checked against the file, a corrupted length must not allocate
+		&& header.length == fileSize - sizeof(header);
+	if (valid) {
+		binary.resize(static_cast<size_t>(header.length));
+		valid = static_cast<bool>(file.read(binary.data(), binary.size()));
+	}
+	file.close();
+
+	if (valid) {
+		glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+		GLint success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		valid = success == GL_TRUE;
+	}
+	if (!valid) {
+		//either a corrupted file or the driver refuses it, in both case the binary is useless
+		this->stat.reject++;
+		std::filesystem::remove(path, err);
+		return false;
+	}
+
+	this->stat.hit++;
+	return true;
+}
+
+void SgTProgramCache::storeProgram(const GLuint program, const SgTHash key) {
+	this->queryDriver();
+	if (!this->binarySupported) {
+		return;
+	}
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+	SgTCacheHeader header = { SgTProgramCache::MAGIC, 0u, key, 0ull };
+	std::vector<char> binary(static_cast<size_t>(length));
+	GLsizei written = 0;
+	glGetProgramBinary(program, length, &written, &header.format, binary.data());
+	header.length = static_cast<unsigned long long>(written);
+
+	std::error_code err;
+	std::filesystem::create_directories(this->Directory, err);
+	//write to a temporary file first, so other processes never see a partially written binary
+	const SgTstring path = this->getCachePath(key);
+	const SgTstring tempPath = path + ".tmp";
+	std::ofstream file(tempPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!file.is_open()) {
+		return;
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(binary.data(), written);
+	file.close();
+	if (file.fail()) {
+		std::filesystem::remove(tempPath, err);
+		return;
+	}
+	std::filesystem::rename(tempPath, path, err);
+}
+
+const SgTProgramCache::SgTCacheStat SgTProgramCache::getStat() const {
+	return this->stat;
+}
+
+void SgTProgramCache::resetStat() {
+	this->stat = { 0u, 0u, 0u };
+}
\ No newline at end of file
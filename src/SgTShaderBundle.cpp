@@ -0,0 +1,129 @@
+#include "SgTShaderBundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+using namespace SglToolkit;
+
+SgTShaderBundle::SgTShaderBundle(const SgTstring path) : mapping(path) {
+	const char* const data = this->mapping.getData();
+	const size_t length = this->mapping.getLength();
+	if (length < sizeof(SgTBundleHeader)) {
+		throw "InvalidBundleException";
+	}
+	SgTBundleHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (header.magic != SgTShaderBundle::MAGIC || header.version != SgTShaderBundle::VERSION
+		|| (length - sizeof(header)) / sizeof(SgTBundleEntry) < header.count) {
+		throw "InvalidBundleException";
+	}
+	//the mapping is page aligned and the header is a multiple of 8 byte, so entries are aligned
+	this->entry = reinterpret_cast<const SgTBundleEntry*>(data + sizeof(header));
+	this->count = header.count;
+
+	//validate once, such that lookups never go out of the mapping
+	for (uint32_t i = 0u; i < this->count; i++) {
+		const SgTBundleEntry& e = this->entry[i];
+		if (e.nameOffset > length || e.nameLength > length - e.nameOffset
+			|| e.dataOffset >= length || e.dataLength >= length - e.dataOffset || data[e.dataOffset + e.dataLength] != '\0'
+			|| (i > 0u && this->entry[i - 1u].nameHash > e.nameHash)) {
+			throw "InvalidBundleException";
+		}
+	}
+}
+
+SgTShaderBundle::~SgTShaderBundle() {
+
+}
+
+void SgTShaderBundle::write(const SgTstring path, const std::vector<std::pair<SgTstring, SgTstring>>& shader) {
+	std::vector<size_t> order(shader.size());
+	std::vector<SgTHash> nameHash(shader.size());
+	for (size_t i = 0; i < shader.size(); i++) {
+		order[i] = i;
+		nameHash[i] = SgTUtils::hashFNV(shader[i].first);
+	}
+	std::sort(order.begin(), order.end(), [&nameHash, &shader](const size_t a, const size_t b) {
+		return nameHash[a] != nameHash[b] ? nameHash[a] < nameHash[b] : shader[a].first < shader[b].first;
+	});
+	for (size_t i = 1; i < order.size(); i++) {
+		if (shader[order[i - 1]].first == shader[order[i]].first) {
+			throw "DuplicatedShaderException";
+		}
+	}
+
+	const SgTBundleHeader header = { SgTShaderBundle::MAGIC, SgTShaderBundle::VERSION, static_cast<uint32_t>(shader.size()), 0u };
+	std::vector<SgTBundleEntry> table(shader.size());
+	uint64_t offset = sizeof(header) + sizeof(SgTBundleEntry) * table.size();
+	for (size_t i = 0; i < order.size(); i++) {
+		const SgTstring& name = shader[order[i]].first;
+		table[i].nameHash = nameHash[order[i]];
+		table[i].nameOffset = offset;
+		table[i].nameLength = name.length();
+		offset += name.length();
+	}
+	for (size_t i = 0; i < order.size(); i++) {
+		const SgTstring& code = shader[order[i]].second;
+		table[i].contentHash = SgTUtils::hashFNV(code);
+		table[i].dataOffset = offset;
+		table[i].dataLength = code.length();
+		offset += code.length() + 1u;
+	}
+
+	//write to a temporary file first, so a running program never maps a partially written bundle
+	const SgTstring tempPath = path + ".tmp";
+	std::ofstream file(tempPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!file.is_open()) {
+		throw "FileNotWritableException";
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(table.data()), sizeof(SgTBundleEntry) * table.size());
+	for (const size_t i : order) {
+		file.write(shader[i].first.data(), shader[i].first.length());
+	}
+	for (const size_t i : order) {
+		//keep the null terminator so the source can be used as a C string
+		file.write(shader[i].second.c_str(), shader[i].second.length() + 1u);
+	}
+	file.close();
+
+	std::error_code err;
+	if (file.fail()) {
+		std::filesystem::remove(tempPath, err);
+		throw "FileNotWritableException";
+	}
+	std::filesystem::rename(tempPath, path, err);
+	if (err) {
+		std::filesystem::remove(tempPath, err);
+		throw "FileNotWritableException";
+	}
+}
+
+const bool SgTShaderBundle::find(const SgTstring& name, SgTBundleShader& shader) const {
+	const SgTHash hash = SgTUtils::hashFNV(name);
+	const SgTBundleEntry* const end = this->entry + this->count;
+	const SgTBundleEntry* e = std::lower_bound(this->entry, end, hash, [](const SgTBundleEntry& a, const SgTHash b) {
+		return a.nameHash < b;
+	});
+	//names are compared to rule out hash collision
+	const char* const data = this->mapping.getData();
+	for (; e != end && e->nameHash == hash; e++) {
+		if (e->nameLength == name.length() && std::memcmp(data + e->nameOffset, name.data(), name.length()) == 0) {
+			shader.data = data + e->dataOffset;
+			shader.length = static_cast<size_t>(e->dataLength);
+			shader.contentHash = e->contentHash;
+			return true;
+		}
+	}
+	return false;
+}
+
+const SgTShaderBundle::SgTBundleShader SgTShaderBundle::getShader(const SgTstring& name) const {
+	SgTBundleShader shader;
+	if (!this->find(name, shader)) {
+		throw "ShaderNotFoundException";
+	}
+	return shader;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "SgTShaderPipeline.h"
+#include "SgTUtils.h"
+
+#include <algorithm>
+
+using namespace SglToolkit;
+
+namespace {
+	//The stage bit of each stage, in the order of shader handles
+	constexpr GLbitfield STAGE_BIT[6] = {
+		GL_VERTEX_SHADER_BIT, GL_TESS_CONTROL_SHADER_BIT, GL_TESS_EVALUATION_SHADER_BIT,
+		GL_GEOMETRY_SHADER_BIT, GL_FRAGMENT_SHADER_BIT, GL_COMPUTE_SHADER_BIT
+	};
+}
+
+SgTShaderPipeline::SgTShaderPipeline() {
+
+}
+
+SgTShaderPipeline::~SgTShaderPipeline() {
+	this->clear();
+}
+
+const GLuint SgTShaderPipeline::getPipeline(const SgTShaderProc* const* const program, const unsigned int count) {
+	//find which program provides each stage
+	GLuint stageProgram[6] = { 0u, 0u, 0u, 0u, 0u, 0u };
+	for (unsigned int i = 0u; i < count; i++) {
+		const GLbitfield stage = program[i]->getStageBit();
+		for (int j = 0; j < 6; j++) {
+			if ((stage & STAGE_BIT[j]) != 0u) {
+				stageProgram[j] = static_cast<GLuint>(program[i]->getP());
+			}
+		}
+	}
+	SgTHash key = SgTUtils::FNV_OFFSET;
+	for (int j = 0; j < 6; j++) {
+		key = SgTUtils::hashCombine(key, stageProgram[j]);
+	}
+
+	//the hash only narrows the search, the stages are compared so a collision never binds the wrong programs
+	const auto range = this->pipeline.equal_range(key);
+	for (auto it = range.first; it != range.second; it++) {
+		if (std::equal(stageProgram, stageProgram + 6, it->second.program)) {
+			return it->second.pipeline;
+		}
+	}
+	//a new combination, only the pipeline object is created and nothing is linked
+	SgTPipelineEntry entry;
+	glGenProgramPipelines(1, &entry.pipeline);
+	for (int j = 0; j < 6; j++) {
+		entry.program[j] = stageProgram[j];
+		if (stageProgram[j] != 0u) {
+			glUseProgramStages(entry.pipeline, STAGE_BIT[j], stageProgram[j]);
+		}
+	}
+	this->pipeline.emplace(key, entry);
+
+	return entry.pipeline;
+}
+
+void SgTShaderPipeline::removeProgram(const SgTShaderProc& program) {
+	this->removeProgram(static_cast<GLuint>(program.getP()));
+}
+
+void SgTShaderPipeline::removeProgram(const GLuint handle) {
+	if (handle == 0u) {
+		//unused stages are also 0
+		return;
+	}
+	for (auto it = this->pipeline.begin(); it != this->pipeline.end();) {
+		const GLuint* const stage = it->second.program;
+		if (std::find(stage, stage + 6, handle) != stage + 6) {
+			glDeleteProgramPipelines(1, &it->second.pipeline);
+			it = this->pipeline.erase(it);
+		}
+		else {
+			it++;
+		}
+	}
+}
+
+void SgTShaderPipeline::clear() {
+	for (const auto& [key, entry] : this->pipeline) {
+		glDeleteProgramPipelines(1, &entry.pipeline);
+	}
+	this->pipeline.clear();
+}
+
+const size_t SgTShaderPipeline::getPipelineCount() const {
+	return this->pipeline.size();
+}
\ No newline at end of file
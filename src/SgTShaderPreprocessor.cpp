@@ -0,0 +1,312 @@
+#include "SgTShaderPreprocessor.h"
+
+#include <string_view>
+
+using namespace SglToolkit;
+
+namespace {
+	/**
+	 * @brief A preprocessor directive, e.g. "#include "a.glsl"" has keyword "include" and argument ""a.glsl""
+	*/
+	struct SgTDirective {
+		std::string_view keyword;
+		std::string_view argument;
+	};
+
+	//Remove leading and trailing white space
+	std::string_view trim(std::string_view str) {
+		const size_t first = str.find_first_not_of(" \t\r");
+		if (first == std::string_view::npos) {
+			return std::string_view();
+		}
+		const size_t last = str.find_last_not_of(" \t\r");
+		return str.substr(first, last - first + 1);
+	}
+
+	/**
+	 * @brief Parse a line as a directive, comment is not considered
+	 * @param line The line
+	 * @param directive The parsed directive
+	 * @return True if the line is a directive
+	*/
+	bool parseDirective(const std::string_view line, SgTDirective& directive) {
+		std::string_view str = trim(line);
+		if (str.empty() || str.front() != '#') {
+			return false;
+		}
+		str = trim(str.substr(1));
+		const size_t end = str.find_first_of(" \t");
+		directive.keyword = str.substr(0, end);
+		directive.argument = end == std::string_view::npos ? std::string_view() : trim(str.substr(end));
+		//anything after a line comment is not part of the argument
+		const size_t comment = directive.argument.find("//");
+		if (comment != std::string_view::npos) {
+			directive.argument = trim(directive.argument.substr(0, comment));
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Track if the end of a line is inside a block comment
+	 * @param line The line
+	 * @param inComment True if the start of the line is inside a block comment
+	 * @return True if the end of the line is inside a block comment
+	*/
+	bool scanComment(const std::string_view line, bool inComment) {
+		for (size_t i = 0; i + 1 < line.length(); i++) {
+			if (inComment) {
+				if (line[i] == '*' && line[i + 1] == '/') {
+					inComment = false;
+					i++;
+				}
+			}
+			else if (line[i] == '/' && line[i + 1] == '/') {
+				break;
+			}
+			else if (line[i] == '/' && line[i + 1] == '*') {
+				inComment = true;
+				i++;
+			}
+		}
+		return inComment;
+	}
+
+	//Split the content into lines, '\n' is not included
+	std::vector<std::string_view> splitLine(const std::string_view content) {
+		std::vector<std::string_view> line;
+		size_t start = 0;
+		while (start < content.length()) {
+			size_t end = content.find('\n', start);
+			if (end == std::string_view::npos) {
+				end = content.length();
+			}
+			line.push_back(content.substr(start, end - start));
+			start = end + 1;
+		}
+		return line;
+	}
+
+	/**
+	 * @brief Find the include guard macro of a file, a file is guarded if its first two directives are "#ifndef X" and "#define X",
+	 * and its last directive is "#endif"
+	 * @param line All lines in the file
+	 * @return The guard macro, or empty if the file is not guarded
+	*/
+	std::string_view findGuard(const std::vector<std::string_view>& line) {
+		std::vector<SgTDirective> directive;
+		bool inComment = false;
+		for (const std::string_view& l : line) {
+			SgTDirective d;
+			if (!inComment && parseDirective(l, d)) {
+				directive.push_back(d);
+			}
+			inComment = scanComment(l, inComment);
+		}
+		if (directive.size() < 3 || directive[0].keyword != "ifndef" || directive[1].keyword != "define"
+			|| directive.back().keyword != "endif") {
+			return std::string_view();
+		}
+		//the define may have a value
+		const std::string_view guard = directive[0].argument;
+		const std::string_view defined = directive[1].argument.substr(0, directive[1].argument.find_first_of(" \t"));
+		return guard == defined ? guard : std::string_view();
+	}
+}
+
+SgTShaderPreprocessor::SgTShaderPreprocessor(SgTSourceCache* const cache) : Cache(cache) {
+
+}
+
+SgTShaderPreprocessor::~SgTShaderPreprocessor() {
+
+}
+
+const SgTstring SgTShaderPreprocessor::normalisePath(const SgTstring& path) {
+	std::error_code err;
+	const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, err);
+	if (err) {
+		return std::filesystem::absolute(path).lexically_normal().generic_string();
+	}
+	return canonical.generic_string();
+}
+
+void SgTShaderPreprocessor::addIncludePath(const SgTstring path) {
+	this->includePath.push_back(path);
+}
+
+const int SgTShaderPreprocessor::getFileNumber(const SgTstring& path) {
+	const auto it = this->fileNumber.find(path);
+	if (it != this->fileNumber.end()) {
+		return it->second;
+	}
+	const int number = static_cast<int>(this->fileName.size());
+	this->fileName.push_back(path);
+	this->fileNumber.emplace(path, number);
+	return number;
+}
+
+const SgTstring SgTShaderPreprocessor::readFile(const SgTstring& path) {
+	if (this->Cache != nullptr) {
+		const SgTSourceCache::SgTSourceView view = this->Cache->getSource(path);
+		return SgTstring(view.data, view.length);
+	}
+	//read without going through SgTShaderProc, so the preprocessor can be used by offline tools without OpenGL
+	const SgTFileMapping mapping(path);
+	return SgTstring(mapping.getData(), mapping.getLength());
+}
+
+const SgTstring SgTShaderPreprocessor::resolveInclude(const SgTstring& name, const SgTstring& includer) const {
+	//relative to the including file first
+	const std::filesystem::path local = std::filesystem::path(includer).parent_path() / name;
+	if (std::filesystem::is_regular_file(local)) {
+		return SgTShaderPreprocessor::normalisePath(local.string());
+	}
+	for (const SgTstring& dir : this->includePath) {
+		const std::filesystem::path search = std::filesystem::path(dir) / name;
+		if (std::filesystem::is_regular_file(search)) {
+			return SgTShaderPreprocessor::normalisePath(search.string());
+		}
+	}
+	throw "IncludeNotFoundException";
+}
+
+void SgTShaderPreprocessor::expandFile(const SgTstring& path, SgTExpansion& expansion, const int depth) {
+	if (depth > SgTShaderPreprocessor::MAX_INCLUDE_DEPTH) {
+		throw "IncludeDepthException";
+	}
+	//the file is a dependency even if it is not expanded
+	if (path != expansion.root) {
+		this->dependency[expansion.root].insert(path);
+		this->dependent[path].insert(expansion.root);
+	}
+	if (expansion.onceFile.count(path) != 0) {
+		return;
+	}
+
+	const SgTstring content = this->readFile(path);
+	const std::vector<std::string_view> line = splitLine(content);
+	const std::string_view guard = findGuard(line);
+	if (!guard.empty() && !expansion.guard.insert(SgTstring(guard)).second) {
+		//guard has been defined, the whole file will be skipped by the driver anyway
+		return;
+	}
+
+	const SgTstring number = std::to_string(this->getFileNumber(path));
+	const bool isRoot = depth == 0;
+	bool hasVersion = false;
+	if (isRoot) {
+		//#version must be the first directive, so the line mapping of the root starts after it
+		for (const std::string_view& l : line) {
+			SgTDirective d;
+			if (parseDirective(l, d) && d.keyword == "version") {
+				hasVersion = true;
+				break;
+			}
+		}
+	}
+	if (!hasVersion) {
+		expansion.code += "#line 1 " + number + "\n";
+	}
+
+	bool inComment = false;
+	for (size_t i = 0; i < line.size(); i++) {
+		//#line refers to the line following the directive, line number starts from 1
+		const SgTstring nextLine = std::to_string(i + 2);
+		const std::string_view l = line[i];
+		SgTDirective d;
+		if (inComment || !parseDirective(l, d)) {
+			expansion.code.append(l).append("\n");
+		}
+		else if (d.keyword == "version") {
+			if (isRoot) {
+				expansion.code.append(l).append("\n#line " + nextLine + " " + number + "\n");
+			}
+			else {
+				//only one #version is allowed per shader
+				expansion.code.append("\n");
+			}
+		}
+		else if (d.keyword == "pragma" && trim(d.argument) == "once") {
+			expansion.onceFile.insert(path);
+			expansion.code.append("\n");
+		}
+		else if (d.keyword == "include") {
+			if (d.argument.length() < 2
+				|| !((d.argument.front() == '"' && d.argument.back() == '"') || (d.argument.front() == '<' && d.argument.back() == '>'))) {
+				throw "InvalidIncludeException";
+			}
+			const SgTstring name = SgTstring(d.argument.substr(1, d.argument.length() - 2));
+			const size_t before = expansion.code.length();
+			this->expandFile(this->resolveInclude(name, path), expansion, depth + 1);
+			if (expansion.code.length() == before) {
+				//nothing is expanded, keep the line count
+				expansion.code.append("\n");
+			}
+			else {
+				expansion.code.append("#line " + nextLine + " " + number + "\n");
+			}
+		}
+		else {
+			expansion.code.append(l).append("\n");
+		}
+		inComment = scanComment(l, inComment);
+	}
+}
+
+const SgTstring SgTShaderPreprocessor::preprocess(const SgTstring path) {
+	const SgTstring root = SgTShaderPreprocessor::normalisePath(path);
+	//dependency may have changed since the last time the shader was preprocessed
+	const auto it = this->dependency.find(root);
+	if (it != this->dependency.end()) {
+		for (const SgTstring& file : it->second) {
+			this->dependent[file].erase(root);
+		}
+		this->dependency.erase(it);
+	}
+
+	this->dependency.emplace(root, std::unordered_set<SgTstring>());
+
+	SgTExpansion expansion;
+	expansion.root = root;
+	this->expandFile(root, expansion, 0);
+
+	return expansion.code;
+}
+
+const std::vector<SgTstring> SgTShaderPreprocessor::getDependent(const SgTstring path) const {
+	const SgTstring file = SgTShaderPreprocessor::normalisePath(path);
+	std::vector<SgTstring> shader;
+	if (this->dependency.count(file) != 0) {
+		shader.push_back(file);
+	}
+	const auto it = this->dependent.find(file);
+	if (it != this->dependent.end()) {
+		shader.insert(shader.end(), it->second.cbegin(), it->second.cend());
+	}
+	return shader;
+}
+
+const std::vector<SgTstring> SgTShaderPreprocessor::getDependency(const SgTstring shader) const {
+	const auto it = this->dependency.find(SgTShaderPreprocessor::normalisePath(shader));
+	if (it == this->dependency.end()) {
+		return std::vector<SgTstring>();
+	}
+	return std::vector<SgTstring>(it->second.cbegin(), it->second.cend());
+}
+
+const bool SgTShaderPreprocessor::dependsOn(const SgTstring shader, const SgTstring path) const {
+	const SgTstring root = SgTShaderPreprocessor::normalisePath(shader);
+	const SgTstring file = SgTShaderPreprocessor::normalisePath(path);
+	if (root == file) {
+		return true;
+	}
+	const auto it = this->dependency.find(root);
+	return it != this->dependency.end() && it->second.count(file) != 0;
+}
+
+const SgTstring SgTShaderPreprocessor::getFileName(const int number) const {
+	if (number < 0 || number >= static_cast<int>(this->fileName.size())) {
+		return SgTstring();
+	}
+	return this->fileName[number];
+}
\ No newline at end of file
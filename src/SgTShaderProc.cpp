@@ -1,7 +1,47 @@
 #include "SgTShaderProc.h"
+#include "SgTUtils.h"
+
+#include <algorithm>
+
+//GL_KHR_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+//GL_ARB_gl_spirv
+#ifndef GL_SHADER_BINARY_FORMAT_SPIR_V
+#define GL_SHADER_BINARY_FORMAT_SPIR_V 0x9551
+#endif
 
 using namespace SglToolkit;
 
+SgTShaderProc::SgTLinkFuture::SgTLinkFuture(SgTShaderProc* const proc, const SgTShaderStatus status, const bool resolved) {
+	this->Proc = proc;
+	this->status = status;
+	this->resolved = resolved;
+}
+
+SgTShaderProc::SgTLinkFuture::~SgTLinkFuture() {
+
+}
+
+const bool SgTShaderProc::SgTLinkFuture::isReady() const {
+	if (this->resolved || !SgTShaderProc::hasParallelCompile()) {
+		return true;
+	}
+	//program completion also implies all attached shaders are completed
+	GLint completed = GL_FALSE;
+	glGetProgramiv(this->Proc->shaderHandle[0], GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+const SgTShaderStatus SgTShaderProc::SgTLinkFuture::get(GLchar* log, const int bufferSize) {
+	if (!this->resolved) {
+		this->status = this->Proc->endLink(log, bufferSize);
+		this->resolved = true;
+	}
+	return this->status;
+}
+
 SgTShaderProc::SgTShaderProc() {
 
 }
@@ -10,60 +50,373 @@ SgTShaderProc::~SgTShaderProc() {
 	
 }
 
-void SgTShaderProc::addShader(const GLenum type, const SgTstring path) {
+const int SgTShaderProc::getHandleIndex(const GLenum type) {
 	//Determine which shader is that
-	int handleIndex = 1;
 	switch (type) {
-	case GL_VERTEX_SHADER: handleIndex = 1;
+	case GL_VERTEX_SHADER: return 1;
 		break;
-	case GL_TESS_CONTROL_SHADER: handleIndex = 2;
+	case GL_TESS_CONTROL_SHADER: return 2;
 		break;
-	case GL_TESS_EVALUATION_SHADER: handleIndex = 3;
+	case GL_TESS_EVALUATION_SHADER: return 3;
 		break;
-	case GL_GEOMETRY_SHADER: handleIndex = 4;
+	case GL_GEOMETRY_SHADER: return 4;
 		break;
-	case GL_FRAGMENT_SHADER: handleIndex = 5;
+	case GL_FRAGMENT_SHADER: return 5;
 		break;
-	case GL_COMPUTE_SHADER: handleIndex = 6;
+	case GL_COMPUTE_SHADER: return 6;
 		break;
 	default: throw "InvalidGLenumException";
 		break;
 	}
+}
 
-	//Start working
-	//Read the code from file
-	const SgTstring scode = SgTShaderProc::readCode(path);
-	const char* code = scode.c_str();
-	//We don't need to worry about whether the file exits or not since the readCode function has done that
+const bool SgTShaderProc::allocateShader(const GLenum type, const SgTHash hash) {
+	const int handleIndex = SgTShaderProc::getHandleIndex(type);
+	this->shaderused[handleIndex - 1] = true;
+	this->shaderHash[handleIndex - 1] = hash;
 	//Generating shader
+	if (this->shareShader) {
+		bool created;
+		this->shaderHandle[handleIndex] = SgTShaderRegistry::acquire(type, hash, created);
+		//content has been set by whoever created it
+		return created;
+	}
 	this->shaderHandle[handleIndex] = glCreateShader(type);
-	this->shaderused[handleIndex - 1] = true;
-	//adding the source file
-	glShaderSource(this->shaderHandle[handleIndex], 1, &code, NULL);
+	return true;
+}
+
+void SgTShaderProc::createShader(const GLenum type, const char* const* const code, const GLint* const length, const GLsizei count, const SgTHash* const precomputed) {
+	//the driver concatenates all strings, so does the hash
+	SgTHash hash = SgTUtils::FNV_OFFSET;
+	if (precomputed != nullptr) {
+		hash = *precomputed;
+	}
+	else {
+		for (GLsizei i = 0; i < count; i++) {
+			hash = SgTUtils::hashFNV(code[i], static_cast<size_t>(length[i]), hash);
+		}
+	}
+	if (!this->allocateShader(type, hash)) {
+		return;
+	}
+	//adding the source file, length is given so the code does not need to be null-terminated
+	glShaderSource(this->shaderHandle[SgTShaderProc::getHandleIndex(type)], count, code, length);
+}
+
+void SgTShaderProc::createShaderBinary(const GLenum type, const char* const binary, const size_t length, const SgTSpecialization& specialization) {
+	if (!SgTShaderProc::hasSPIRV()) {
+		throw "SPIRVNotSupportedException";
+	}
+	if (specialization.index.size() != specialization.value.size()) {
+		throw "InvalidSpecializationException";
+	}
+	//the same module specialized differently is a different shader, and it must never match a GLSL source with the same bytes
+	SgTHash hash = SgTUtils::hashFNV(binary, length, SgTUtils::hashFNV(specialization.entryPoint));
+	for (size_t i = 0; i < specialization.index.size(); i++) {
+		hash = SgTUtils::hashCombine(hash, (static_cast<unsigned long long>(specialization.index[i]) << 32ull) | specialization.value[i]);
+	}
+	if (!this->allocateShader(type, hash)) {
+		return;
+	}
+	const GLuint handle = this->shaderHandle[SgTShaderProc::getHandleIndex(type)];
+	glShaderBinary(1, &handle, GL_SHADER_BINARY_FORMAT_SPIR_V, binary, static_cast<GLsizei>(length));
+	//specialization replaces compilation, the result is reported through the compile status
+	glSpecializeShader(handle, specialization.entryPoint.c_str(), static_cast<GLuint>(specialization.index.size()),
+		specialization.index.data(), specialization.value.data());
+}
+
+void SgTShaderProc::destroyShader(const GLuint handle) {
+	if (!SgTShaderRegistry::release(handle)) {
+		glDeleteShader(handle);
+	}
+}
+
+void SgTShaderProc::loadShader(const GLenum type, const SgTShaderSource& source) {
+	//check the type before reading anything
+	const int handleIndex = SgTShaderProc::getHandleIndex(type);
+	if (this->programLabel.name.empty()) {
+		this->programLabel.name = source.path;
+	}
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::LOAD, "loadShader", source.path, &this->programLabel);
+
+	//Start working
+	//Read the code from file
+	if (source.binary) {
+		if (source.cache != nullptr) {
+			SgTSourceCache::SgTSourceView view;
+			{
+				const SgTShaderProfiler::SgTScope ioScope(SgTShaderProfiler::IO, "getSource", source.path);
+				view = source.cache->getSource(source.path);
+			}
+			this->createShaderBinary(type, view.data, view.length, source.specialization);
+		}
+		else {
+			SgTFileMapping module;
+			{
+				const SgTShaderProfiler::SgTScope ioScope(SgTShaderProfiler::IO, "mapFile", source.path);
+				module = SgTFileMapping(source.path);
+			}
+			this->createShaderBinary(type, module.getData(), module.getLength(), source.specialization);
+		}
+	}
+	else if (source.preprocessor != nullptr) {
+		SgTstring scode;
+		{
+			const SgTShaderProfiler::SgTScope ioScope(SgTShaderProfiler::IO, "preprocess", source.path);
+			scode = source.preprocessor->preprocess(source.path);
+		}
+		const char* const code = scode.c_str();
+		const GLint length = static_cast<GLint>(scode.length());
+		this->createShader(type, &code, &length, 1);
+	}
+	else if (source.cache != nullptr) {
+		//mapped memory is passed to the driver directly, no intermediate copy
+		SgTSourceCache::SgTSourceView view;
+		{
+			const SgTShaderProfiler::SgTScope ioScope(SgTShaderProfiler::IO, "getSource", source.path);
+			view = source.cache->getSource(source.path);
+		}
+		const GLint length = static_cast<GLint>(view.length);
+		this->createShader(type, &view.data, &length, 1);
+	}
+	else {
+		const SgTstring scode = SgTShaderProc::readCode(source.path);
+		//We don't need to worry about whether the file exits or not since the readCode function has done that
+		const char* const code = scode.c_str();
+		const GLint length = static_cast<GLint>(scode.length());
+		this->createShader(type, &code, &length, 1);
+	}
+	this->shaderSource[handleIndex - 1] = source;
+	//specialized shader is already compiled
+	this->shaderCompiled[handleIndex - 1] = source.binary;
 
 	//Finished
 }
 
+void SgTShaderProc::addShader(const GLenum type, const SgTstring path) {
+	SgTShaderSource source;
+	source.path = SgTShaderPreprocessor::normalisePath(path);
+	this->loadShader(type, source);
+}
+
+void SgTShaderProc::addShader(const GLenum type, const SgTstring path, SgTSourceCache& cache) {
+	SgTShaderSource source;
+	source.path = SgTShaderPreprocessor::normalisePath(path);
+	source.cache = &cache;
+	this->loadShader(type, source);
+}
+
+void SgTShaderProc::addShader(const GLenum type, const SgTstring path, SgTShaderPreprocessor& preprocessor) {
+	SgTShaderSource source;
+	source.path = SgTShaderPreprocessor::normalisePath(path);
+	source.preprocessor = &preprocessor;
+	this->loadShader(type, source);
+}
+
+void SgTShaderProc::addShaderBinary(const GLenum type, const SgTstring path, const SgTSpecialization& specialization) {
+	SgTShaderSource source;
+	source.path = SgTShaderPreprocessor::normalisePath(path);
+	source.binary = true;
+	source.specialization = specialization;
+	this->loadShader(type, source);
+}
+
+void SgTShaderProc::addShaderBinary(const GLenum type, const SgTstring path, SgTSourceCache& cache, const SgTSpecialization& specialization) {
+	SgTShaderSource source;
+	source.path = SgTShaderPreprocessor::normalisePath(path);
+	source.cache = &cache;
+	source.binary = true;
+	source.specialization = specialization;
+	this->loadShader(type, source);
+}
+
+void SgTShaderProc::addShader(const GLenum type, const SgTstring name, const SgTShaderBundle& bundle) {
+	const int handleIndex = SgTShaderProc::getHandleIndex(type);
+	if (this->programLabel.name.empty()) {
+		this->programLabel.name = name;
+	}
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::LOAD, "addShader", name, &this->programLabel);
+
+	const SgTShaderBundle::SgTBundleShader shader = bundle.getShader(name);
+	const GLint length = static_cast<GLint>(shader.length);
+	this->createShader(type, &shader.data, &length, 1, &shader.contentHash);
+	//the bundle is read-only, there is nothing to rebuild from
+	this->shaderSource[handleIndex - 1] = SgTShaderSource();
+	this->shaderCompiled[handleIndex - 1] = false;
+}
+
+void SgTShaderProc::addShaderSource(const GLenum type, const char* const* const code, const GLint* const length, const GLsizei count) {
+	const int handleIndex = SgTShaderProc::getHandleIndex(type);
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::LOAD, "addShaderSource", SgTstring(), &this->programLabel);
+
+	this->createShader(type, code, length, count);
+	//there is no file behind the shader, it cannot be rebuilt
+	this->shaderSource[handleIndex - 1] = SgTShaderSource();
+	this->shaderCompiled[handleIndex - 1] = false;
+}
+
+SgTShaderStatus SgTShaderProc::rebuildShader(const std::vector<SgTstring>& changed, GLchar* log, const int bufferSize, SgTProgramPara arg) {
+	static const GLenum type[6] = {
+		GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER,
+		GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER
+	};
+	//find which shader is affected by the changed files
+	bool affected[6] = { false, false, false, false, false, false };
+	bool anyAffected = false;
+	for (int i = 0; i < 6; i++) {
+		if (!this->shaderused[i]) {
+			continue;
+		}
+		const SgTShaderSource& source = this->shaderSource[i];
+		for (const SgTstring& file : changed) {
+			affected[i] = source.preprocessor != nullptr ? source.preprocessor->dependsOn(source.path, file)
+				: source.path == SgTShaderPreprocessor::normalisePath(file);
+			if (affected[i]) {
+				anyAffected = true;
+				break;
+			}
+		}
+	}
+	if (!anyAffected) {
+		return this->OK;
+	}
+
+	//backup the current program, it is restored if anything goes wrong
+	GLuint oldHandle[7];
+	SgTHash oldHash[6];
+	bool oldCompiled[6];
+	std::copy(this->shaderHandle, this->shaderHandle + 7, oldHandle);
+	std::copy(this->shaderHash, this->shaderHash + 6, oldHash);
+	std::copy(this->shaderCompiled, this->shaderCompiled + 6, oldCompiled);
+	//shared shader may be given the same handle when the content is unchanged, so track what has been loaded
+	bool loaded[6] = { false, false, false, false, false, false };
+	const auto discardNew = [this, &loaded, &oldHandle, &oldHash, &oldCompiled]() {
+		for (int i = 0; i < 6; i++) {
+			if (loaded[i]) {
+				SgTShaderProc::destroyShader(this->shaderHandle[i + 1]);
+			}
+		}
+		if (this->shaderHandle[0] != oldHandle[0]) {
+			glDeleteProgram(this->shaderHandle[0]);
+		}
+		std::copy(oldHandle, oldHandle + 7, this->shaderHandle);
+		std::copy(oldHash, oldHash + 6, this->shaderHash);
+		std::copy(oldCompiled, oldCompiled + 6, this->shaderCompiled);
+	};
+
+	try {
+		for (int i = 0; i < 6; i++) {
+			if (affected[i]) {
+				//make a copy since loading overwrites the source record
+				const SgTShaderSource source = this->shaderSource[i];
+				this->loadShader(type[i], source);
+				loaded[i] = true;
+			}
+		}
+	}
+	catch (...) {
+		discardNew();
+		throw;
+	}
+	//a new program is created, unchanged shaders are attached to both programs and only the new shaders are compiled
+	this->shaderHandle[0] = 0;
+	const SgTShaderStatus status = this->linkShader(log, bufferSize, arg);
+	if (status != this->OK) {
+		discardNew();
+		return status;
+	}
+
+	//deleting the old program also detaches all old shaders
+	glDeleteProgram(oldHandle[0]);
+	for (int i = 0; i < 6; i++) {
+		if (affected[i]) {
+			SgTShaderProc::destroyShader(oldHandle[i + 1]);
+		}
+	}
+	return this->OK;
+}
+
 SgTShaderStatus SgTShaderProc::linkShader(GLchar* log, const int bufferSize, SgTProgramPara arg) {
+	if (this->beginLink(arg)) {
+		//loaded from the program cache
+		return this->OK;
+	}
+	//all compile and link commands are issued before the first status query, so the driver does not stall on every stage
+	return this->endLink(log, bufferSize);
+	//we will delete the shader source when the class got destructed just in case we need to re-attach it
+}
+
+SgTShaderProc::SgTLinkFuture SgTShaderProc::linkShaderAsync(SgTProgramPara arg) {
+	if (this->beginLink(arg)) {
+		return SgTShaderProc::SgTLinkFuture(this, this->OK, true);
+	}
+	return SgTShaderProc::SgTLinkFuture(this, this->OK, false);
+}
+
+const bool SgTShaderProc::hasParallelCompile() {
+	//capability of the driver does not change, only check it once
+	static const bool supported = SgTUtils::hasExtension("GL_KHR_parallel_shader_compile")
+		|| SgTUtils::hasExtension("GL_ARB_parallel_shader_compile");
+	return supported;
+}
+
+const bool SgTShaderProc::hasSPIRV() {
+	static const bool supported = []() {
+		GLint major = 0, minor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+		return major > 4 || (major == 4 && minor >= 6) || SgTUtils::hasExtension("GL_ARB_gl_spirv");
+	}();
+	return supported;
+}
+
+const bool SgTShaderProc::beginLink(SgTProgramPara arg) {
 	if (this->shaderHandle[0] == 0) {//check if we have a programe
 		//create the programe
 		this->shaderHandle[0] = glCreateProgram();
 	}
+	//try to load the program from the cache before compiling anything
+	if (this->programCache != nullptr) {
+		this->programKey = this->calcProgramKey();
+		bool cached;
+		{
+			const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::LINK, "loadProgram", SgTstring(), &this->programLabel);
+			cached = this->programCache->loadProgram(this->shaderHandle[0], this->programKey);
+		}
+		if (cached) {
+			//attach the shaders anyway so the program can be deleted or relinked in the same way
+			for (int i = 1; i < 7; i++) {
+				if (this->shaderused[i - 1]) {
+					glAttachShader(this->shaderHandle[0], this->shaderHandle[i]);
+				}
+			}
+			this->reflection.reflect(this->shaderHandle[0], this->shaderused[5]);
+			return true;
+		}
+		//binary is only retrievable when the hint is set before linking
+		glProgramParameteri(this->shaderHandle[0], GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+	if (this->separable) {
+		glProgramParameteri(this->shaderHandle[0], GL_PROGRAM_SEPARABLE, GL_TRUE);
+	}
 	//Compile all shaders that have been created
 	for (int i = 1; i < 7; i++) {//shader start from 1
 
 		if (this->shaderused[i - 1]) { //if shader exists
-			//compile it
-			glCompileShader(this->shaderHandle[i]);
-			//check for error
-			if (!this->debugCompile(this->shaderHandle[i], true, log, bufferSize)) {//if error occurs
-				//return to user which shader causes the error
-				return this->VERTEX_SHADER_ERR + (i - 1);//this will effectively output the shader we are looping
+			//compile it, error is checked after the program is linked
+			if (!this->shaderCompiled[i - 1]) {
+				static const char* const stageName[6] = {
+					"compile vertex", "compile tess control", "compile tess evaluation", "compile geometry", "compile fragment", "compile compute"
+				};
+				const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::COMPILE, stageName[i - 1], this->shaderSource[i - 1].path, &this->programLabel);
+				//shared shader may have been compiled by other programs
+				if (!SgTShaderRegistry::compile(this->shaderHandle[i])) {
+					glCompileShader(this->shaderHandle[i]);
+				}
+				this->shaderCompiled[i - 1] = true;
 			}
-
-			//No error? attach shaders to programe
+			//attach shaders to programe
 			glAttachShader(this->shaderHandle[0], this->shaderHandle[i]);
-			
 		}
 	}
 
@@ -73,15 +426,106 @@ SgTShaderStatus SgTShaderProc::linkShader(GLchar* log, const int bufferSize, SgT
 	}
 
 	//We have attached all shaders, now link the programe
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::LINK, "glLinkProgram", SgTstring(), &this->programLabel);
 	glLinkProgram(this->shaderHandle[0]);
-	//check for error
+	return false;
+}
+
+const SgTShaderStatus SgTShaderProc::endLink(GLchar* log, const int bufferSize) {
+	//status queries block until the driver finishes, which is where the time goes with parallel compile
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::WAIT, "endLink", SgTstring(), &this->programLabel);
+	//check for error of each shader
+	for (int i = 1; i < 7; i++) {
+		if (this->shaderused[i - 1] && !this->debugCompile(this->shaderHandle[i], true, log, bufferSize)) {//if error occurs
+			//return to user which shader causes the error
+			return this->VERTEX_SHADER_ERR + (i - 1);//this will effectively output the shader we are looping
+		}
+	}
+	//check for error of the program
 	if (!this->debugCompile(this->shaderHandle[0], false, log, bufferSize)) {
 		return this->PROGRAME_LINKING_ERR;
 	}
+	if (this->programCache != nullptr) {
+		this->programCache->storeProgram(this->shaderHandle[0], this->programKey);
+	}
+	//resources are queried once, so no lookup goes to the driver afterwards
+	this->reflection.reflect(this->shaderHandle[0], this->shaderused[5]);
 
 	//everything works fine
 	return this->OK;
-	//we will delete the shader source when the class got destructed just in case we need to re-attach it
+}
+
+void SgTShaderProc::useProgramCache(SgTProgramCache* const cache, const SgTstring tag) {
+	this->programCache = cache;
+	this->programTag = tag;
+}
+
+const SgTHash SgTShaderProc::calcProgramKey() {
+	//program key consists of the driver, all stages in used and the pre-link settings
+	SgTHash key = this->programCache->getDriverHash();
+	for (int i = 0; i < 6; i++) {
+		if (this->shaderused[i]) {
+			key = SgTUtils::hashCombine(key, static_cast<unsigned long long>(i));
+			key = SgTUtils::hashCombine(key, this->shaderHash[i]);
+		}
+	}
+	key = SgTUtils::hashCombine(key, this->separable ? 1ull : 0ull);
+	key = SgTUtils::hashFNV(this->programTag, key);
+
+	return key;
+}
+
+void SgTShaderProc::useShaderRegistry(const bool share) {
+	this->shareShader = share;
+}
+
+void SgTShaderProc::useSeparable(const bool separable) {
+	this->separable = separable;
+}
+
+const SgTShaderReflection& SgTShaderProc::getReflection() const {
+	return this->reflection;
+}
+
+void SgTShaderProc::setName(const SgTstring name) {
+	this->programLabel.name = name;
+}
+
+const SgTstring& SgTShaderProc::getName() const {
+	return this->programLabel.name;
+}
+
+const GLbitfield SgTShaderProc::getStageBit() const {
+	static const GLbitfield bit[6] = {
+		GL_VERTEX_SHADER_BIT, GL_TESS_CONTROL_SHADER_BIT, GL_TESS_EVALUATION_SHADER_BIT,
+		GL_GEOMETRY_SHADER_BIT, GL_FRAGMENT_SHADER_BIT, GL_COMPUTE_SHADER_BIT
+	};
+	GLbitfield stage = 0u;
+	for (int i = 0; i < 6; i++) {
+		if (this->shaderused[i]) {
+			stage |= bit[i];
+		}
+	}
+	return stage;
+}
+
+const std::vector<SgTstring> SgTShaderProc::getSourceFile() const {
+	std::vector<SgTstring> file;
+	for (int i = 0; i < 6; i++) {
+		const SgTShaderSource& source = this->shaderSource[i];
+		if (!this->shaderused[i] || source.path.empty()) {
+			continue;
+		}
+		file.push_back(source.path);
+		if (source.preprocessor != nullptr) {
+			const std::vector<SgTstring> include = source.preprocessor->getDependency(source.path);
+			file.insert(file.end(), include.cbegin(), include.cend());
+		}
+	}
+	//the same header may be included by many shaders
+	std::sort(file.begin(), file.end());
+	file.erase(std::unique(file.begin(), file.end()), file.end());
+	return file;
 }
 
 void SgTShaderProc::deleteShader() {
@@ -91,19 +535,24 @@ void SgTShaderProc::deleteShader() {
 		for (int i = 1; i < 7; i++) {
 			if (this->shaderused[i - 1]) {//shader exists
 				glDetachShader(this->shaderHandle[0], this->shaderHandle[i]);
-				glDeleteShader(this->shaderHandle[i]);
+				SgTShaderProc::destroyShader(this->shaderHandle[i]);
 
 				this->shaderused[i - 1] = false;
+				this->shaderHash[i - 1] = 0ull;
+				this->shaderCompiled[i - 1] = false;
+				this->shaderSource[i - 1] = SgTShaderSource();
 				this->shaderHandle[i] = 0;
 			}
 		}
 		//delete the programe
 		glDeleteProgram(this->shaderHandle[0]);
 		this->shaderHandle[0] = 0;//clear up the pointer such that it can be reused
+		this->reflection.clear();
 	}
 }
 
 const SgTstring SgTShaderProc::readCode(const SgTstring Path) {
+	const SgTShaderProfiler::SgTScope scope(SgTShaderProfiler::IO, "readCode", Path);
 	//return value
 	SgTstring code;
 	//create the file stream
@@ -0,0 +1,201 @@
+#include "SgTShaderProfiler.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+using namespace SglToolkit;
+
+std::atomic<bool> SgTShaderProfiler::enabled(false);
+std::mutex SgTShaderProfiler::eventLock;
+std::vector<SgTShaderProfiler::SgTEvent> SgTShaderProfiler::event;
+const std::chrono::steady_clock::time_point SgTShaderProfiler::epoch = std::chrono::steady_clock::now();
+std::atomic<unsigned long long> SgTShaderProfiler::serialCount(0ull);
+
+namespace {
+	//The program of the innermost scope on this thread
+	thread_local const SgTShaderProfiler::SgTProgramLabel* currentProgram = nullptr;
+	//Threads are numbered in the order they first record an event, so the trace viewer shows readable thread IDs
+	std::atomic<size_t> threadCount(0);
+	thread_local const size_t threadID = threadCount++;
+
+	//Escape a string for JSON
+	void writeJSONString(std::ostream& output, const char* const str, const size_t length) {
+		output << '"';
+		for (size_t i = 0; i < length; i++) {
+			const unsigned char c = static_cast<unsigned char>(str[i]);
+			if (c == '"' || c == '\\') {
+				output << '\\' << str[i];
+			}
+			else if (c < 0x20u) {
+				output << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(c) << std::dec;
+			}
+			else {
+				output << str[i];
+			}
+		}
+		output << '"';
+	}
+}
+
+SgTShaderProfiler::SgTProgramLabel::SgTProgramLabel() : serial(++SgTShaderProfiler::serialCount) {
+
+}
+
+SgTShaderProfiler::SgTProgramLabel::SgTProgramLabel(const SgTProgramLabel& label) : serial(++SgTShaderProfiler::serialCount), name(label.name) {
+
+}
+
+SgTShaderProfiler::SgTProgramLabel& SgTShaderProfiler::SgTProgramLabel::operator=(const SgTProgramLabel& label) {
+	this->name = label.name;
+	return *this;
+}
+
+SgTShaderProfiler::SgTScope::SgTScope(const char* const category, const char* const name, const SgTstring& detail, const SgTProgramLabel* const program) {
+	this->active = SgTShaderProfiler::isEnabled();
+	this->parentProgram = currentProgram;
+	if (!this->active) {
+		return;
+	}
+	this->name = name;
+	this->category = category;
+	this->detail = detail;
+	if (program != nullptr) {
+		currentProgram = program;
+	}
+	this->begin = std::chrono::steady_clock::now();
+}
+
+SgTShaderProfiler::SgTScope::~SgTScope() {
+	if (!this->active) {
+		return;
+	}
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	SgTEvent e;
+	e.name = this->name;
+	e.category = this->category;
+	e.detail = std::move(this->detail);
+	e.serial = currentProgram == nullptr ? 0ull : currentProgram->getSerial();
+	e.program = currentProgram == nullptr ? SgTstring() : currentProgram->name;
+	e.begin = std::chrono::duration_cast<std::chrono::nanoseconds>(this->begin - SgTShaderProfiler::epoch).count();
+	e.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->begin).count();
+	e.thread = threadID;
+	currentProgram = this->parentProgram;
+
+	const std::lock_guard<std::mutex> lock(SgTShaderProfiler::eventLock);
+	SgTShaderProfiler::event.push_back(std::move(e));
+}
+
+void SgTShaderProfiler::enable(const bool enable) {
+	SgTShaderProfiler::enabled.store(enable, std::memory_order_relaxed);
+}
+
+void SgTShaderProfiler::clear() {
+	const std::lock_guard<std::mutex> lock(SgTShaderProfiler::eventLock);
+	SgTShaderProfiler::event.clear();
+}
+
+const std::vector<SgTShaderProfiler::SgTEvent> SgTShaderProfiler::getEvent() {
+	const std::lock_guard<std::mutex> lock(SgTShaderProfiler::eventLock);
+	return SgTShaderProfiler::event;
+}
+
+const std::vector<SgTShaderProfiler::SgTProgramTime> SgTShaderProfiler::getSlowest(const size_t count) {
+	//names are not unique, e.g. two programs sharing a vertex shader file, so only the serial number tells programs apart
+	std::unordered_map<unsigned long long, SgTProgramTime> program;
+	{
+		const std::lock_guard<std::mutex> lock(SgTShaderProfiler::eventLock);
+		for (const SgTEvent& e : SgTShaderProfiler::event) {
+			auto it = program.find(e.serial);
+			if (it == program.end()) {
+				it = program.emplace(e.serial, SgTProgramTime{ e.serial, SgTstring(), 0ll, 0ll, 0ll, 0ll, 0ll, 0ll }).first;
+			}
+			SgTProgramTime& time = it->second;
+			//the program may be renamed after some events are recorded
+			if (!e.program.empty()) {
+				time.program = e.program;
+			}
+			if (std::strcmp(e.category, SgTShaderProfiler::IO) == 0) {
+				time.io += e.duration;
+			}
+			else if (std::strcmp(e.category, SgTShaderProfiler::LOAD) == 0) {
+				time.load += e.duration;
+			}
+			else if (std::strcmp(e.category, SgTShaderProfiler::COMPILE) == 0) {
+				time.compile += e.duration;
+			}
+			else if (std::strcmp(e.category, SgTShaderProfiler::LINK) == 0) {
+				time.link += e.duration;
+			}
+			else if (std::strcmp(e.category, SgTShaderProfiler::WAIT) == 0) {
+				time.wait += e.duration;
+			}
+		}
+	}
+
+	std::vector<SgTProgramTime> slowest;
+	slowest.reserve(program.size());
+	for (auto& p : program) {
+		//io is nested inside load, unless the file is read outside any shader processor
+		SgTProgramTime& time = p.second;
+		time.total = std::max(time.load, time.io) + time.compile + time.link + time.wait;
+		slowest.push_back(std::move(time));
+	}
+	std::sort(slowest.begin(), slowest.end(), [](const SgTProgramTime& a, const SgTProgramTime& b) {
+		return a.total > b.total;
+	});
+	if (slowest.size() > count) {
+		slowest.resize(count);
+	}
+	return slowest;
+}
+
+void SgTShaderProfiler::writeTrace(const SgTstring path) {
+	const std::vector<SgTEvent> all = SgTShaderProfiler::getEvent();
+	std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+	if (!file.is_open()) {
+		throw "FileNotWritableException";
+	}
+
+	//complete events, time is in microsecond
+	file << "{\"traceEvents\":[";
+	file << std::fixed << std::setprecision(3);
+	for (size_t i = 0; i < all.size(); i++) {
+		const SgTEvent& e = all[i];
+		file << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+		writeJSONString(file, e.name, std::strlen(e.name));
+		file << ",\"cat\":\"" << e.category << "\",\"ph\":\"X\",\"ts\":" << e.begin / 1000.0 << ",\"dur\":" << e.duration / 1000.0
+			<< ",\"pid\":0,\"tid\":" << e.thread << ",\"args\":{\"serial\":" << e.serial << ",\"program\":";
+		writeJSONString(file, e.program.c_str(), e.program.length());
+		file << ",\"file\":";
+		writeJSONString(file, e.detail.c_str(), e.detail.length());
+		file << "}}";
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	file.close();
+	if (file.fail()) {
+		throw "FileNotWritableException";
+	}
+}
+
+void SgTShaderProfiler::writeSummary(std::ostream& output, const size_t count) {
+	const std::vector<SgTProgramTime> slowest = SgTShaderProfiler::getSlowest(count);
+	const auto ms = [](const long long ns) {
+		return static_cast<double>(ns) / 1.0e6;
+	};
+
+	const std::ios_base::fmtflags flag = output.flags();
+	const std::streamsize precision = output.precision();
+	output << std::fixed << std::setprecision(3);
+	output << std::setw(10) << "total" << std::setw(10) << "load" << std::setw(10) << "io" << std::setw(10) << "compile"
+		<< std::setw(10) << "link" << std::setw(10) << "wait" << std::setw(8) << "id" << "  program\n";
+	for (const SgTProgramTime& time : slowest) {
+		output << std::setw(10) << ms(time.total) << std::setw(10) << ms(time.load) << std::setw(10) << ms(time.io)
+			<< std::setw(10) << ms(time.compile) << std::setw(10) << ms(time.link) << std::setw(10) << ms(time.wait)
+			<< std::setw(8) << time.serial << "  " << (time.program.empty() ? "(unnamed)" : time.program) << "\n";
+	}
+	output.flags(flag);
+	output.precision(precision);
+}
\ No newline at end of file
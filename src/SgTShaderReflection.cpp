@@ -0,0 +1,108 @@
+#include "SgTShaderReflection.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SglToolkit;
+
+namespace {
+	//Sort a table by name for binary search
+	template<class Info>
+	void sortByName(std::vector<Info>& table) {
+		std::sort(table.begin(), table.end(), [](const Info& a, const Info& b) {
+			return a.name < b.name;
+		});
+	}
+}
+
+SgTShaderReflection::SgTShaderReflection() {
+
+}
+
+SgTShaderReflection::~SgTShaderReflection() {
+
+}
+
+const SgTHash SgTShaderReflection::getResourceName(const GLuint program, const GLenum programInterface, const GLuint index, std::vector<GLchar>& buffer) {
+	GLsizei length = 0;
+	glGetProgramResourceName(program, programInterface, index, static_cast<GLsizei>(buffer.size()), &length, buffer.data());
+	//arrays are reported as the first element
+	if (length >= 3 && std::strncmp(buffer.data() + length - 3, "[0]", 3) == 0) {
+		length -= 3;
+	}
+	return SgTUtils::hashFNV(buffer.data(), static_cast<size_t>(length));
+}
+
+void SgTShaderReflection::reflectBlock(const GLuint program, const GLenum programInterface, std::vector<SgTBlockInfo>& table) {
+	GLint count = 0, nameLength = 0;
+	glGetProgramInterfaceiv(program, programInterface, GL_ACTIVE_RESOURCES, &count);
+	glGetProgramInterfaceiv(program, programInterface, GL_MAX_NAME_LENGTH, &nameLength);
+	std::vector<GLchar> name(static_cast<size_t>(nameLength) + 1u);
+
+	const GLenum prop[2] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+	table.reserve(static_cast<size_t>(count));
+	for (GLint i = 0; i < count; i++) {
+		GLint value[2];
+		glGetProgramResourceiv(program, programInterface, i, 2, prop, 2, NULL, value);
+		table.push_back(SgTBlockInfo{
+			SgTShaderReflection::getResourceName(program, programInterface, i, name), static_cast<GLuint>(i), value[0], value[1]
+		});
+	}
+	sortByName(table);
+}
+
+void SgTShaderReflection::reflect(const GLuint program, const bool compute) {
+	this->clear();
+
+	//uniforms, in the default block or uniform blocks
+	GLint count = 0, nameLength = 0;
+	glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+	glGetProgramInterfaceiv(program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &nameLength);
+	std::vector<GLchar> name(static_cast<size_t>(nameLength) + 1u);
+	{
+		const GLenum prop[7] = { GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET, GL_ARRAY_STRIDE, GL_MATRIX_STRIDE };
+		this->uniform.reserve(static_cast<size_t>(count));
+		for (GLint i = 0; i < count; i++) {
+			GLint value[7];
+			glGetProgramResourceiv(program, GL_UNIFORM, i, 7, prop, 7, NULL, value);
+			this->uniform.push_back(SgTUniformInfo{
+				SgTShaderReflection::getResourceName(program, GL_UNIFORM, i, name),
+				value[0], static_cast<GLenum>(value[1]), value[2], value[3], value[4], value[5], value[6]
+			});
+		}
+		sortByName(this->uniform);
+	}
+
+	SgTShaderReflection::reflectBlock(program, GL_UNIFORM_BLOCK, this->uniformBlock);
+	SgTShaderReflection::reflectBlock(program, GL_SHADER_STORAGE_BLOCK, this->storageBlock);
+
+	//members of shader storage blocks
+	glGetProgramInterfaceiv(program, GL_BUFFER_VARIABLE, GL_ACTIVE_RESOURCES, &count);
+	glGetProgramInterfaceiv(program, GL_BUFFER_VARIABLE, GL_MAX_NAME_LENGTH, &nameLength);
+	name.resize(static_cast<size_t>(nameLength) + 1u);
+	{
+		const GLenum prop[7] = { GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET, GL_ARRAY_STRIDE, GL_MATRIX_STRIDE, GL_TOP_LEVEL_ARRAY_STRIDE };
+		this->bufferVariable.reserve(static_cast<size_t>(count));
+		for (GLint i = 0; i < count; i++) {
+			GLint value[7];
+			glGetProgramResourceiv(program, GL_BUFFER_VARIABLE, i, 7, prop, 7, NULL, value);
+			this->bufferVariable.push_back(SgTBufferVariableInfo{
+				SgTShaderReflection::getResourceName(program, GL_BUFFER_VARIABLE, i, name),
+				static_cast<GLenum>(value[0]), value[1], value[2], value[3], value[4], value[5], value[6]
+			});
+		}
+		sortByName(this->bufferVariable);
+	}
+
+	if (compute) {
+		glGetProgramiv(program, GL_COMPUTE_WORK_GROUP_SIZE, this->workGroupSize);
+	}
+}
+
+void SgTShaderReflection::clear() {
+	this->uniform.clear();
+	this->uniformBlock.clear();
+	this->storageBlock.clear();
+	this->bufferVariable.clear();
+	std::fill(this->workGroupSize, this->workGroupSize + 3, 0);
+}
\ No newline at end of file
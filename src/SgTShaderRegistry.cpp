@@ -0,0 +1,54 @@
+#include "SgTShaderRegistry.h"
+#include "SgTUtils.h"
+
+using namespace SglToolkit;
+
+std::unordered_map<SgTHash, SgTShaderRegistry::SgTSharedShader> SgTShaderRegistry::shader;
+std::unordered_map<GLuint, SgTHash> SgTShaderRegistry::shaderKey;
+
+const GLuint SgTShaderRegistry::acquire(const GLenum type, const SgTHash hash, bool& created) {
+	const SgTHash key = SgTUtils::hashCombine(hash, static_cast<unsigned long long>(type));
+	const auto it = SgTShaderRegistry::shader.find(key);
+	if (it != SgTShaderRegistry::shader.end()) {
+		it->second.reference++;
+		created = false;
+		return it->second.handle;
+	}
+
+	const GLuint handle = glCreateShader(type);
+	SgTShaderRegistry::shader.emplace(key, SgTSharedShader{ handle, 1u, false });
+	SgTShaderRegistry::shaderKey.emplace(handle, key);
+	created = true;
+	return handle;
+}
+
+const bool SgTShaderRegistry::release(const GLuint handle) {
+	const auto key = SgTShaderRegistry::shaderKey.find(handle);
+	if (key == SgTShaderRegistry::shaderKey.end()) {
+		return false;
+	}
+	const auto it = SgTShaderRegistry::shader.find(key->second);
+	if (--it->second.reference == 0u) {
+		glDeleteShader(handle);
+		SgTShaderRegistry::shader.erase(it);
+		SgTShaderRegistry::shaderKey.erase(key);
+	}
+	return true;
+}
+
+const bool SgTShaderRegistry::compile(const GLuint handle) {
+	const auto key = SgTShaderRegistry::shaderKey.find(handle);
+	if (key == SgTShaderRegistry::shaderKey.end()) {
+		return false;
+	}
+	SgTSharedShader& shared = SgTShaderRegistry::shader.at(key->second);
+	if (!shared.compiled) {
+		glCompileShader(handle);
+		shared.compiled = true;
+	}
+	return true;
+}
+
+const size_t SgTShaderRegistry::getShaderCount() {
+	return SgTShaderRegistry::shader.size();
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "SgTShaderVariant.h"
+
+#include <cctype>
+#include <algorithm>
+
+using namespace SglToolkit;
+
+namespace {
+	//Check if a keyword appears in the code as a whole identifier
+	bool hasIdentifier(const SgTstring& code, const SgTstring& identifier) {
+		const auto isIdentifierChar = [](const char c) {
+			return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+		};
+		for (size_t pos = code.find(identifier); pos != SgTstring::npos; pos = code.find(identifier, pos + 1)) {
+			const size_t end = pos + identifier.length();
+			if ((pos == 0 || !isIdentifierChar(code[pos - 1])) && (end == code.length() || !isIdentifierChar(code[end]))) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+SgTShaderVariant::SgTShaderVariant(const std::vector<SgTstring>& keyword, SgTProgramPara arg) : Keyword(keyword), Arg(arg) {
+	if (this->Keyword.size() > SgTShaderVariant::MAX_KEYWORD) {
+		throw "TooManyKeywordException";
+	}
+	for (const SgTstring& k : this->Keyword) {
+		this->defineLine.push_back("#define " + k + "\n");
+	}
+	this->variant.resize(static_cast<size_t>(1u) << this->Keyword.size());
+}
+
+SgTShaderVariant::~SgTShaderVariant() {
+	for (const auto& proc : this->variant) {
+		if (proc) {
+			proc->deleteShader();
+		}
+	}
+}
+
+void SgTShaderVariant::addSource(const GLenum type, const SgTstring& code) {
+	for (const auto& proc : this->variant) {
+		if (proc) {
+			throw "VariantBuiltException";
+		}
+	}
+
+	SgTVariantSource variantSource;
+	variantSource.type = type;
+	variantSource.versionEnd = 0;
+	variantSource.nextLine = "1";
+	//#version must stay the first directive, so defines are injected after it
+	int lineNumber = 1;
+	for (size_t start = 0; start < code.length(); lineNumber++) {
+		size_t end = code.find('\n', start);
+		end = end == SgTstring::npos ? code.length() : end + 1;
+		const size_t first = code.find_first_not_of(" \t", start);
+		if (first < end && code.compare(first, 8, "#version") == 0) {
+			variantSource.versionEnd = end;
+			variantSource.nextLine = std::to_string(lineNumber + 1);
+			break;
+		}
+		start = end;
+	}
+	//only keywords referenced by the shader make a difference
+	variantSource.keywordMask = 0u;
+	for (size_t i = 0; i < this->Keyword.size(); i++) {
+		if (hasIdentifier(code, this->Keyword[i])) {
+			variantSource.keywordMask |= 1u << i;
+		}
+	}
+	variantSource.code = code;
+
+	this->source.push_back(std::move(variantSource));
+}
+
+void SgTShaderVariant::addShader(const GLenum type, const SgTstring path) {
+	this->addSource(type, SgTShaderProc::readCode(path));
+	if (this->baseName.empty()) {
+		this->baseName = path;
+	}
+}
+
+void SgTShaderVariant::addShader(const GLenum type, const SgTstring path, SgTShaderPreprocessor& preprocessor) {
+	this->addSource(type, preprocessor.preprocess(path));
+	if (this->baseName.empty()) {
+		this->baseName = path;
+	}
+}
+
+void SgTShaderVariant::addVariantShader(SgTShaderProc& proc, const unsigned int mask) {
+	for (const SgTVariantSource& variantSource : this->source) {
+		const unsigned int stageMask = mask & variantSource.keywordMask;
+		SgTstring define;
+		for (size_t i = 0; i < this->defineLine.size(); i++) {
+			if ((stageMask & (1u << i)) != 0u) {
+				define += this->defineLine[i];
+			}
+		}
+		if (!define.empty()) {
+			//restore the line number such that driver errors point at the base source
+			define += "#line " + variantSource.nextLine + " 0\n";
+		}
+
+		const char* const code[3] = {
+			variantSource.code.c_str(),
+			define.c_str(),
+			variantSource.code.c_str() + variantSource.versionEnd
+		};
+		const GLint length[3] = {
+			static_cast<GLint>(variantSource.versionEnd),
+			static_cast<GLint>(define.length()),
+			static_cast<GLint>(variantSource.code.length() - variantSource.versionEnd)
+		};
+		proc.addShaderSource(variantSource.type, code, length, 3);
+	}
+}
+
+SgTShaderStatus SgTShaderVariant::build(const unsigned int* const mask, const unsigned int count, GLchar* log, const int bufferSize) {
+	//validate every mask before anything is compiled, so nothing is left half built when it throws
+	for (unsigned int i = 0u; i < count; i++) {
+		if (mask[i] >= this->variant.size()) {
+			throw "InvalidMaskException";
+		}
+	}
+
+	SgTShaderStatus firstStatus = SgTShaderProc::OK;
+	//log of later failures must not overwrite the first one
+	std::vector<GLchar> scratch(static_cast<size_t>(bufferSize > 0 ? bufferSize : 1));
+
+	const unsigned int batchSize = this->BATCH_SIZE > 0u ? this->BATCH_SIZE : 1u;
+	for (unsigned int begin = 0u; begin < count; begin += batchSize) {
+		const unsigned int end = std::min(count, begin + batchSize);
+
+		//issue all compilations of the batch before waiting for any of them
+		std::vector<std::pair<unsigned int, std::unique_ptr<SgTShaderProc>>> pending;
+		std::vector<SgTShaderProc::SgTLinkFuture> future;
+		for (unsigned int i = begin; i < end; i++) {
+			bool duplicated = this->variant[mask[i]] != nullptr;
+			for (const auto& p : pending) {
+				duplicated |= p.first == mask[i];
+			}
+			if (duplicated) {
+				continue;
+			}
+
+			std::unique_ptr<SgTShaderProc> proc = std::make_unique<SgTShaderProc>();
+			proc->useShaderRegistry(true);
+			//sources have no file behind them, so each variant is named before any shader is added
+			proc->setName(this->baseName + "#" + std::to_string(mask[i]));
+			this->addVariantShader(*proc, mask[i]);
+			future.push_back(proc->linkShaderAsync(this->Arg));
+			pending.emplace_back(mask[i], std::move(proc));
+		}
+
+		for (size_t i = 0; i < pending.size(); i++) {
+			const bool firstFailure = firstStatus == SgTShaderProc::OK;
+			const SgTShaderStatus status = future[i].get(firstFailure ? log : scratch.data(), bufferSize);
+			if (status == SgTShaderProc::OK) {
+				this->variant[pending[i].first] = std::move(pending[i].second);
+				continue;
+			}
+			if (firstFailure) {
+				firstStatus = status;
+			}
+			pending[i].second->deleteShader();
+		}
+	}
+
+	return firstStatus;
+}
+
+SgTShaderStatus SgTShaderVariant::buildAll(GLchar* log, const int bufferSize) {
+	std::vector<unsigned int> mask(this->variant.size());
+	for (unsigned int i = 0u; i < mask.size(); i++) {
+		mask[i] = i;
+	}
+	return this->build(mask.data(), static_cast<unsigned int>(mask.size()), log, bufferSize);
+}
+
+SgTShaderProc* const SgTShaderVariant::require(const unsigned int mask, GLchar* log, const int bufferSize) {
+	if (mask < this->variant.size() && this->variant[mask] != nullptr) {
+		return this->variant[mask].get();
+	}
+	if (this->build(&mask, 1u, log, bufferSize) != SgTShaderProc::OK) {
+		return nullptr;
+	}
+	return this->variant[mask].get();
+}
+
+const unsigned int SgTShaderVariant::getKeywordBit(const SgTstring& keyword) const {
+	for (size_t i = 0; i < this->Keyword.size(); i++) {
+		if (this->Keyword[i] == keyword) {
+			return 1u << i;
+		}
+	}
+	return 0u;
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "SgTShaderWatcher.h"
+
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace SglToolkit;
+
+SgTShaderWatcher::SgTShaderWatcher() : running(true) {
+#ifdef __linux__
+	this->notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (this->notifyHandle == -1) {
+		throw "FileWatcherException";
+	}
+	if (pipe2(this->wakePipe, O_NONBLOCK | O_CLOEXEC) == -1) {
+		close(this->notifyHandle);
+		throw "FileWatcherException";
+	}
+#endif
+	this->watcherThread = std::thread(&SgTShaderWatcher::watch, this);
+}
+
+SgTShaderWatcher::~SgTShaderWatcher() {
+	this->running = false;
+#ifdef __linux__
+	const char wake = 0;
+	write(this->wakePipe[1], &wake, 1);
+#else
+	this->watchSignal.notify_all();
+#endif
+	this->watcherThread.join();
+
+#ifdef __linux__
+	close(this->wakePipe[0]);
+	close(this->wakePipe[1]);
+	close(this->notifyHandle);
+#endif
+}
+
+void SgTShaderWatcher::watch() {
+#ifdef __linux__
+	pollfd handle[2] = {
+		{ this->notifyHandle, POLLIN, 0 },
+		{ this->wakePipe[0], POLLIN, 0 }
+	};
+	//buffer must be aligned for inotify_event
+	alignas(inotify_event) char buffer[4096];
+	while (this->running) {
+		if (poll(handle, 2, -1) <= 0 || (handle[0].revents & POLLIN) == 0) {
+			continue;
+		}
+		ssize_t length;
+		while ((length = read(this->notifyHandle, buffer, sizeof(buffer))) > 0) {
+			std::unique_lock<std::mutex> lock(this->watchLock);
+			for (char* ptr = buffer; ptr < buffer + length;) {
+				const inotify_event* const event = reinterpret_cast<const inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+
+				const auto dir = this->watchDirectory.find(event->wd);
+				if (event->len == 0 || dir == this->watchDirectory.end()) {
+					continue;
+				}
+				//events are reported for every file in the directory, only watched files are interested
+				const SgTstring path = dir->second + "/" + event->name;
+				if (this->watchedFile.count(path) != 0) {
+					this->notifyChange(path);
+				}
+			}
+		}
+	}
+#else
+	std::unique_lock<std::mutex> lock(this->watchLock);
+	while (this->running) {
+		this->watchSignal.wait_for(lock, SgTShaderWatcher::POLL_INTERVAL);
+		for (auto& [path, time] : this->modifiedTime) {
+			std::error_code err;
+			const std::filesystem::file_time_type current = std::filesystem::last_write_time(path, err);
+			if (!err && current != time) {
+				time = current;
+				this->notifyChange(path);
+			}
+		}
+	}
+#endif
+}
+
+void SgTShaderWatcher::addFile(const SgTstring& path) {
+	if (this->watchedFile[path]++ != 0) {
+		return;
+	}
+#ifdef __linux__
+	//editors often save by replacing the file, so the directory is watched instead of the file
+	const SgTstring dir = std::filesystem::path(path).parent_path().generic_string();
+	if (this->directoryWatch.count(dir) == 0) {
+		const int wd = inotify_add_watch(this->notifyHandle, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (wd != -1) {
+			this->directoryWatch.emplace(dir, wd);
+			this->watchDirectory.emplace(wd, dir);
+		}
+	}
+#else
+	std::error_code err;
+	this->modifiedTime[path] = std::filesystem::last_write_time(path, err);
+#endif
+}
+
+void SgTShaderWatcher::removeFile(const SgTstring& path) {
+	const auto it = this->watchedFile.find(path);
+	if (it == this->watchedFile.end() || --it->second != 0) {
+		return;
+	}
+	//directory watch is kept, it is cheap and the directory is likely to be watched again
+	this->watchedFile.erase(it);
+	this->pendingFile.erase(path);
+#ifndef __linux__
+	this->modifiedTime.erase(path);
+#endif
+}
+
+void SgTShaderWatcher::notifyChange(const SgTstring& path) {
+	//a later event restarts the settle time
+	this->pendingFile[path] = std::chrono::steady_clock::now();
+}
+
+void SgTShaderWatcher::addProgram(SgTShaderProc* const proc, SgTProgramPara arg) {
+	SgTWatchEntry watchEntry = { proc, arg, proc->getSourceFile() };
+
+	std::unique_lock<std::mutex> lock(this->watchLock);
+	for (const SgTstring& file : watchEntry.file) {
+		this->addFile(file);
+	}
+	this->entry.push_back(std::move(watchEntry));
+}
+
+void SgTShaderWatcher::removeProgram(SgTShaderProc* const proc) {
+	std::unique_lock<std::mutex> lock(this->watchLock);
+	for (auto it = this->entry.begin(); it != this->entry.end();) {
+		if (it->proc == proc) {
+			for (const SgTstring& file : it->file) {
+				this->removeFile(file);
+			}
+			it = this->entry.erase(it);
+		}
+		else {
+			it++;
+		}
+	}
+}
+
+const std::vector<SgTShaderWatcher::SgTReloadResult> SgTShaderWatcher::process(const int bufferSize) {
+	std::vector<SgTReloadResult> result;
+	//take all files that have been quiet for long enough
+	std::vector<SgTstring> settled;
+	{
+		std::unique_lock<std::mutex> lock(this->watchLock);
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (auto it = this->pendingFile.begin(); it != this->pendingFile.end();) {
+			if (now - it->second >= this->SETTLE_TIME) {
+				settled.push_back(it->first);
+				it = this->pendingFile.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+	}
+	if (settled.empty()) {
+		return result;
+	}
+	const std::unordered_set<SgTstring> settledSet(settled.cbegin(), settled.cend());
+
+	std::vector<GLchar> log(static_cast<size_t>(bufferSize > 0 ? bufferSize : 1), '\0');
+	for (SgTWatchEntry& watchEntry : this->entry) {
+		bool affected = false;
+		for (const SgTstring& file : watchEntry.file) {
+			if (settledSet.count(file) != 0) {
+				affected = true;
+				break;
+			}
+		}
+		if (!affected) {
+			continue;
+		}
+
+		log[0] = '\0';
+		//the program is replaced by the rebuild, so its handle is taken before
+		const GLuint oldProgram = static_cast<GLuint>(watchEntry.proc->getP());
+		SgTShaderStatus status;
+		try {
+			status = watchEntry.proc->rebuildShader(settled, log.data(), bufferSize, watchEntry.arg);
+		}
+		catch (...) {
+			//file may be removed or half written, the program is kept and retried on the next change
+			continue;
+		}
+		result.push_back(SgTReloadResult{ watchEntry.proc, oldProgram, status,
+			status == SgTShaderProc::OK ? SgTstring() : SgTstring(log.data()) });
+
+		//includes may be changed
+		std::vector<SgTstring> file = watchEntry.proc->getSourceFile();
+		std::unique_lock<std::mutex> lock(this->watchLock);
+		for (const SgTstring& f : file) {
+			this->addFile(f);
+		}
+		for (const SgTstring& f : watchEntry.file) {
+			this->removeFile(f);
+		}
+		watchEntry.file = std::move(file);
+	}
+
+	return result;
+}
\ No newline at end of file
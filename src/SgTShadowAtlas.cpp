@@ -0,0 +1,198 @@
+#include "SgTShadowAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace SglToolkit;
+
+SgTShadowAtlas::SgTShadowAtlas(const unsigned int size, const unsigned int maxTile, const unsigned int minTile) : Size(size), MaxTile(maxTile), MinTile(minTile) {
+	const auto isPowerOfTwo = [](const unsigned int v) {
+		return v != 0u && (v & (v - 1u)) == 0u;
+	};
+	if (!isPowerOfTwo(size) || !isPowerOfTwo(maxTile) || !isPowerOfTwo(minTile) || minTile > maxTile || maxTile > size) {
+		throw "InvalidAtlasSizeException";
+	}
+
+	this->maxLevel = 0u;
+	size_t nodeCount = 1;
+	for (size_t levelCount = 1; (this->Size >> this->maxLevel) > this->MinTile; ) {
+		this->maxLevel++;
+		levelCount *= 4;
+		nodeCount += levelCount;
+	}
+	this->node.assign(nodeCount, SgTNodeState::FREE);
+}
+
+SgTShadowAtlas::~SgTShadowAtlas() {
+
+}
+
+const unsigned int SgTShadowAtlas::getLevel(const float coverage) const {
+	//the number of texel should follow the number of pixel covered, so the side follows the square root
+	const float desired = static_cast<float>(this->MaxTile) * std::sqrt(glm::clamp(coverage, 0.0f, 1.0f));
+	unsigned int level = 0u;
+	while (this->getLevelSize(level) > this->MaxTile) {
+		level++;
+	}
+	//the smallest power of two that is not smaller than the desired size
+	while (level < this->maxLevel && static_cast<float>(this->getLevelSize(level + 1u)) >= desired) {
+		level++;
+	}
+	return level;
+}
+
+const bool SgTShadowAtlas::allocateNode(const size_t index, const unsigned int level, const GLint x, const GLint y, const unsigned int target, SgTAllocation& result) {
+	const SgTNodeState state = this->node[index];
+	if (state == SgTNodeState::USED) {
+		return false;
+	}
+	if (level == target) {
+		if (state != SgTNodeState::FREE) {
+			return false;
+		}
+		this->node[index] = SgTNodeState::USED;
+		result = SgTAllocation{ index, level, x, y, true };
+		return true;
+	}
+	//children of a free node are always free, so splitting it always succeeds
+	if (state == SgTNodeState::FREE) {
+		this->node[index] = SgTNodeState::SPLIT;
+	}
+
+	const GLint half = static_cast<GLint>(this->getLevelSize(level + 1u));
+	const size_t child = 4 * index + 1;
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t c = 0; c < 4; c++) {
+			const bool split = this->node[child + c] == SgTNodeState::SPLIT;
+			if ((pass == 0) == split
+				&& this->allocateNode(child + c, level + 1u, x + static_cast<GLint>(c & 1u) * half, y + static_cast<GLint>(c >> 1u) * half, target, result)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void SgTShadowAtlas::freeNode(size_t index) {
+	this->node[index] = SgTNodeState::FREE;
+	while (index != 0) {
+		const size_t parent = (index - 1) / 4;
+		const size_t child = 4 * parent + 1;
+		for (size_t c = 0; c < 4; c++) {
+			if (this->node[child + c] != SgTNodeState::FREE) {
+				return;
+			}
+		}
+		this->node[parent] = SgTNodeState::FREE;
+		index = parent;
+	}
+}
+
+void SgTShadowAtlas::fillTile(const SgTAllocation& alloc, const bool reused, SgTShadowTile& tile) const {
+	const unsigned int size = this->getLevelSize(alloc.level);
+	const float atlasSize = static_cast<float>(this->Size);
+	const float scale = static_cast<float>(size) / atlasSize;
+	tile.x = alloc.x;
+	tile.y = alloc.y;
+	tile.size = static_cast<GLsizei>(size);
+	tile.uvTransform = SgTvec4(scale, scale, static_cast<float>(alloc.x) / atlasSize, static_cast<float>(alloc.y) / atlasSize);
+	tile.reused = reused;
+}
+
+const size_t SgTShadowAtlas::update(const SgTShadowRequest* const request, const size_t count, SgTShadowTile* const tile) {
+	for (auto& a : this->allocation) {
+		a.second.requested = false;
+	}
+
+	//when the tiles do not fit, all of them are halved together rather than starving the smaller ones
+	std::vector<unsigned int>& requestLevel = this->requestLevel;
+	requestLevel.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		requestLevel[i] = this->getLevel(request[i].coverage);
+	}
+	const unsigned long long atlasArea = static_cast<unsigned long long>(this->Size) * this->Size;
+	unsigned int bias = 0u;
+	for (; bias < this->maxLevel; bias++) {
+		unsigned long long area = 0ull;
+		for (size_t i = 0; i < count; i++) {
+			const unsigned long long size = this->getLevelSize(std::min(requestLevel[i] + bias, this->maxLevel));
+			area += size * size;
+		}
+		if (area <= atlasArea) {
+			break;
+		}
+	}
+
+	//lights keep their tile if it has the same size, or it is one level larger, so the tile does not flicker between two sizes
+	size_t tileCount = 0;
+	std::vector<std::pair<unsigned int, size_t>>& pending = this->pending;
+	pending.clear();
+	pending.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		tile[i] = SgTShadowTile{ 0, 0, 0, SgTvec4(0.0f, 0.0f, 0.0f, 0.0f), false };
+		const unsigned int level = std::min(requestLevel[i] + bias, this->maxLevel);
+		const auto it = this->allocation.find(request[i].key);
+		if (it != this->allocation.end() && !it->second.requested && (it->second.level == level || it->second.level + 1u == level)) {
+			it->second.requested = true;
+			this->fillTile(it->second, true, tile[i]);
+			tileCount++;
+			continue;
+		}
+		pending.emplace_back(level, i);
+	}
+
+	//free the tiles of lights that are gone or have changed size
+	for (auto it = this->allocation.begin(); it != this->allocation.end(); ) {
+		if (!it->second.requested) {
+			this->freeNode(it->second.node);
+			it = this->allocation.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	//largest tiles first to reduce fragmentation
+	std::sort(pending.begin(), pending.end());
+	//if a level is full, every larger tile is full as well
+	unsigned int firstLevel = 0u;
+	for (const auto& p : pending) {
+		const SgTShadowRequest& r = request[p.second];
+		if (this->allocation.find(r.key) != this->allocation.end()) {
+			continue;
+		}
+		for (unsigned int level = std::max(p.first, firstLevel); level <= this->maxLevel; level++) {
+			SgTAllocation alloc;
+			if (this->allocateNode(0, 0u, 0, 0, level, alloc)) {
+				this->allocation.emplace(r.key, alloc);
+				this->fillTile(alloc, false, tile[p.second]);
+				tileCount++;
+				break;
+			}
+			firstLevel = level + 1u;
+		}
+	}
+	return tileCount;
+}
+
+const bool SgTShadowAtlas::getTile(const SgTHash key, SgTShadowTile& tile) const {
+	const auto it = this->allocation.find(key);
+	if (it == this->allocation.end()) {
+		return false;
+	}
+	this->fillTile(it->second, true, tile);
+	return true;
+}
+
+void SgTShadowAtlas::release(const SgTHash key) {
+	const auto it = this->allocation.find(key);
+	if (it != this->allocation.end()) {
+		this->freeNode(it->second.node);
+		this->allocation.erase(it);
+	}
+}
+
+void SgTShadowAtlas::clear() {
+	std::fill(this->node.begin(), this->node.end(), SgTNodeState::FREE);
+	this->allocation.clear();
+}
\ No newline at end of file
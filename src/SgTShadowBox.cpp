@@ -1,10 +1,14 @@
 #include "SgTShadowBox.h"
+#include "SgTSIMD.h"
+
+#include <cmath>
 
 using namespace SglToolkit;
 
 SgTShadowBox::SgTShadowBox(SgTCamera* const camera, const SgTvec3 lightDir, const float nearPlane, const float aspect) : Camera(camera) {
 	this->LightDirection = glm::normalize(lightDir);
 	this->NEAR_PLANE = nearPlane;
+	this->calcLightView();
 	this->calcViewFrustumPlanes(aspect);
 }
 
@@ -12,45 +16,72 @@ SgTShadowBox::~SgTShadowBox() {
 
 }
 
+void SgTShadowBox::calcLightView() {
+	//the light is parallel, so it is placed at the origin and only the rotation matters
+	const SgTvec3 lightUp = std::fabs(glm::dot(this->LightDirection, SgTvec3(this->UP))) > 0.99f ? SgTvec3(1.0f, 0.0f, 0.0f) : SgTvec3(this->UP);
+	this->lightView = glm::lookAt(SgTvec3(0.0f, 0.0f, 0.0f), this->LightDirection, lightUp);
+}
+
+void SgTShadowBox::setLightDirection(const SgTvec3 lightDir) {
+	this->LightDirection = glm::normalize(lightDir);
+	this->calcLightView();
+}
+
+void SgTShadowBox::setSceneBounds(const SgTvec3 min, const SgTvec3 max) {
+	this->sceneBounded = true;
+	this->sceneMin = min;
+	this->sceneMax = max;
+}
+
+void SgTShadowBox::clearSceneBounds() {
+	this->sceneBounded = false;
+}
+
 void SgTShadowBox::calcViewFrustumPlanes(const float aspect) {
-	this->farWidth = static_cast<float>(this->SHADOW_DISTANCE * glm::tan(glm::radians(this->Camera->getZoomDeg())));//zoom degree is out FOV
-	this->nearWidth = static_cast<float>(this->NEAR_PLANE * glm::tan(glm::radians(this->Camera->getZoomDeg())));
+	this->calcViewFrustumPlanes(this->Camera, aspect);
+}
+
+void SgTShadowBox::calcViewFrustumPlanes(SgTCamera* const camera, const float aspect) {
+	this->farWidth = static_cast<float>(this->SHADOW_DISTANCE * glm::tan(glm::radians(camera->getZoomDeg())));//zoom degree is out FOV
+	this->nearWidth = static_cast<float>(this->NEAR_PLANE * glm::tan(glm::radians(camera->getZoomDeg())));
 	//the height can be calculated via aspect ratio
 	this->farHeight = this->farWidth / aspect;
 	this->nearHeight = this->nearWidth / aspect;
 }
 
-const SgTvec4* const SgTShadowBox::calcFrustumVertices(SgTmat4 rotation, SgTvec3 forwardVector, SgTvec3 upVector, SgTvec3 centerNear, SgTvec3 centerFar) {
-	//allocating spaces for the points
-	SgTvec4* const points = new SgTvec4[8];
+void SgTShadowBox::calcFrustumVertices(const SgTvec3 forwardVector, const SgTvec3 upVector, const SgTvec3 centerNear, const SgTvec3 centerFar, SgTFrustumCorner& corner) const {
 	//calculate vectors
 	const SgTvec3 up = upVector;
 	const SgTvec3 right = glm::cross(forwardVector, up);
-	const SgTvec3 down = -up;
-	const SgTvec3 left = -right;
-
-	const SgTvec3 farTop = centerFar + this->farHeight * up;
-	const SgTvec3 farBottom = centerFar + this->farHeight * down;
-	const SgTvec3 nearTop = centerNear + this->nearHeight * up;
-	const SgTvec3 nearBottom = centerNear + this->nearHeight * down;
-	//calculate all the corners
-	*(points + 0) = this->calcFrustumCorner(farTop, right, this->farWidth);
-	*(points + 1) = this->calcFrustumCorner(farTop, left, this->farWidth);
-	*(points + 2) = this->calcFrustumCorner(farBottom, right, this->farWidth);
-	*(points + 3) = this->calcFrustumCorner(farBottom, left, this->farWidth);
-	*(points + 4) = this->calcFrustumCorner(nearTop, right, this->nearWidth);
-	*(points + 5) = this->calcFrustumCorner(nearTop, left, this->nearWidth);
-	*(points + 6) = this->calcFrustumCorner(nearBottom, right, this->nearWidth);
-	*(points + 7) = this->calcFrustumCorner(nearBottom, left, this->nearWidth);
-
-	return points;
-}
-
-const SgTvec4 SgTShadowBox::calcFrustumCorner(SgTvec3 start, SgTvec3 direction, float scale) {
-	SgTvec4 corner = SgTvec4(start + scale * direction, 1.0f);
-	//now the corner is calculated in world space
-
-	return corner;
+	//every corner is center + height * up + width * right, with the sign of height and width given by the corner order
+	const float fh = this->farHeight, nh = this->nearHeight, fw = this->farWidth, nw = this->nearWidth;
+	float* const axis[3] = { corner.x, corner.y, corner.z };
+#if defined(SgT_SIMD_AVX)
+	const __m256 height = _mm256_setr_ps(fh, fh, -fh, -fh, nh, nh, -nh, -nh);
+	const __m256 width = _mm256_setr_ps(fw, -fw, fw, -fw, nw, -nw, nw, -nw);
+	for (int a = 0; a < 3; a++) {
+		//far plane in the lower half, near plane in the upper half
+		const __m256 center = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(centerFar[a])), _mm_set1_ps(centerNear[a]), 1);
+		const __m256 v = _mm256_add_ps(center, _mm256_add_ps(_mm256_mul_ps(height, _mm256_set1_ps(up[a])), _mm256_mul_ps(width, _mm256_set1_ps(right[a]))));
+		_mm256_store_ps(axis[a], v);
+	}
+#elif defined(SgT_SIMD_SSE)
+	const __m128 farHeight = _mm_setr_ps(fh, fh, -fh, -fh), nearHeight = _mm_setr_ps(nh, nh, -nh, -nh);
+	const __m128 farWidth = _mm_setr_ps(fw, -fw, fw, -fw), nearWidth = _mm_setr_ps(nw, -nw, nw, -nw);
+	for (int a = 0; a < 3; a++) {
+		const __m128 u = _mm_set1_ps(up[a]), r = _mm_set1_ps(right[a]);
+		_mm_store_ps(axis[a], _mm_add_ps(_mm_set1_ps(centerFar[a]), _mm_add_ps(_mm_mul_ps(farHeight, u), _mm_mul_ps(farWidth, r))));
+		_mm_store_ps(axis[a] + 4, _mm_add_ps(_mm_set1_ps(centerNear[a]), _mm_add_ps(_mm_mul_ps(nearHeight, u), _mm_mul_ps(nearWidth, r))));
+	}
+#else
+	const float height[8] = { fh, fh, -fh, -fh, nh, nh, -nh, -nh };
+	const float width[8] = { fw, -fw, fw, -fw, nw, -nw, nw, -nw };
+	for (int a = 0; a < 3; a++) {
+		for (int i = 0; i < 8; i++) {
+			axis[a][i] = (i < 4 ? centerFar[a] : centerNear[a]) + height[i] * up[a] + width[i] * right[a];
+		}
+	}
+#endif
 }
 
 const SgTvec3 SgTShadowBox::getCenter() {
@@ -58,17 +89,140 @@ const SgTvec3 SgTShadowBox::getCenter() {
 	float midx = (this->maxX + this->minX) / 2.0f;
 	float midy = (this->maxY + this->minY) / 2.0f;
 	float midz = (this->maxZ + this->minZ) / 2.0f;
-	//the center is in world space
-	SgTvec4 center = SgTvec4(midx, midy, midz, 1.0f);
-	
-	return center;
+	//the mid point is in light space, the inverse of a rotation is its transpose
+	return SgTvec3(glm::transpose(this->lightView) * SgTvec4(midx, midy, midz, 0.0f));
+}
+
+void SgTShadowBox::calcFrustumPlane(const SgTFrustumCorner& corner, SgTvec4* const plane) {
+	//three corners on each plane, in the order of near, far, left, right, top and bottom
+	static constexpr int planeCorner[6][3] = { { 4, 5, 6 }, { 0, 1, 2 }, { 1, 3, 5 }, { 0, 2, 4 }, { 0, 1, 4 }, { 2, 3, 6 } };
+	SgTvec3 inside = SgTvec3(0.0f, 0.0f, 0.0f);
+	for (int i = 0; i < 8; i++) {
+		inside += SgTvec3(corner.x[i], corner.y[i], corner.z[i]);
+	}
+	inside = inside / 8.0f;
+
+	for (int p = 0; p < 6; p++) {
+		const int* const c = planeCorner[p];
+		const SgTvec3 a = SgTvec3(corner.x[c[0]], corner.y[c[0]], corner.z[c[0]]);
+		const SgTvec3 b = SgTvec3(corner.x[c[1]], corner.y[c[1]], corner.z[c[1]]);
+		const SgTvec3 d = SgTvec3(corner.x[c[2]], corner.y[c[2]], corner.z[c[2]]);
+		SgTvec3 normal = glm::normalize(glm::cross(b - a, d - a));
+		//orientate the normal towards the center of the frustum, so the winding of the corners does not matter
+		if (glm::dot(normal, inside - a) < 0.0f) {
+			normal = -normal;
+		}
+		plane[p] = SgTvec4(normal, -glm::dot(normal, a));
+	}
+}
+
+void SgTShadowBox::boundLightSpace(const SgTFrustumCorner& corner) {
+	//transform all corners to light space at once, then find the maximum and minimum value in both X,Y and Z direction
+	SgTFrustumCorner light;
+	SgTSIMD::transform8(&this->lightView[0][0], corner.x, corner.y, corner.z, light.x, light.y, light.z);
+	SgTSIMD::minMax8(light.x, this->minX, this->maxX);
+	SgTSIMD::minMax8(light.y, this->minY, this->maxY);
+	SgTSIMD::minMax8(light.z, this->minZ, this->maxZ);
+}
+
+void SgTShadowBox::clipSceneBounds() {
+	if (this->sceneBounded) {
+		const float* const view = &this->lightView[0][0];
+		SgTFrustumCorner scene;
+		for (int i = 0; i < 8; i++) {
+			scene.x[i] = (i & 1) ? this->sceneMax.x : this->sceneMin.x;
+			scene.y[i] = (i & 2) ? this->sceneMax.y : this->sceneMin.y;
+			scene.z[i] = (i & 4) ? this->sceneMax.z : this->sceneMin.z;
+		}
+		SgTSIMD::transform8(view, scene.x, scene.y, scene.z, scene.x, scene.y, scene.z);
+		float sceneMinX, sceneMaxX, sceneMinY, sceneMaxY, sceneMinZ, sceneMaxZ;
+		SgTSIMD::minMax8(scene.x, sceneMinX, sceneMaxX);
+		SgTSIMD::minMax8(scene.y, sceneMinY, sceneMaxY);
+		SgTSIMD::minMax8(scene.z, sceneMinZ, sceneMaxZ);
+
+		//nothing outside the scene receives shadow
+		this->minX = glm::max(this->minX, sceneMinX);
+		this->maxX = glm::min(this->maxX, sceneMaxX);
+		this->minY = glm::max(this->minY, sceneMinY);
+		this->maxY = glm::min(this->maxY, sceneMaxY);
+		this->minZ = glm::max(this->minZ, sceneMinZ);
+		//but every caster between the light and the view frustum does cast, the light looks at -z
+		this->maxZ = sceneMaxZ;
+		//the view frustum may be outside the scene, the box is then empty
+		this->maxX = glm::max(this->maxX, this->minX);
+		this->maxY = glm::max(this->maxY, this->minY);
+		this->maxZ = glm::max(this->maxZ, this->minZ);
+	}
+}
+
+void SgTShadowBox::fitLightSpace() {
+	this->boundLightSpace(this->frustumCorner);
+	this->clipSceneBounds();
+	this->maxZ += this->OFFSET;
+}
+
+const bool SgTShadowBox::reuseBounds(const float aspect) {
+	const SgTUpdateState& last = this->lastState;
+	const float tolerance = this->CACHE_TOLERANCE;
+	const auto near = [tolerance](const SgTvec3 a, const SgTvec3 b) {
+		const SgTvec3 d = glm::abs(a - b);
+		return d.x <= tolerance && d.y <= tolerance && d.z <= tolerance;
+	};
+
+	this->shadowValid = this->CACHE_BOUNDS && this->stateRecorded
+		&& near(last.position, this->Camera->getPosition()) && near(last.front, this->Camera->getFront()) && near(last.up, this->Camera->getUp())
+		&& near(last.lightDirection, this->LightDirection)
+		&& std::fabs(last.zoom - this->Camera->getZoomDeg()) <= tolerance && std::fabs(last.aspect - aspect) <= tolerance
+		&& last.nearPlane == this->NEAR_PLANE && last.shadowDistance == this->SHADOW_DISTANCE && last.offset == this->OFFSET
+		&& last.upAxis == this->UP && last.forwardAxis == this->FORWARD
+		&& last.sceneBounded == this->sceneBounded && (!this->sceneBounded || (last.sceneMin == this->sceneMin && last.sceneMax == this->sceneMax));
+	return this->shadowValid;
+}
+
+void SgTShadowBox::recordState(const float aspect) {
+	SgTUpdateState& last = this->lastState;
+	last.position = this->Camera->getPosition();
+	last.front = this->Camera->getFront();
+	last.up = this->Camera->getUp();
+	last.lightDirection = this->LightDirection;
+	last.zoom = this->Camera->getZoomDeg();
+	last.aspect = aspect;
+	last.nearPlane = this->NEAR_PLANE;
+	last.shadowDistance = this->SHADOW_DISTANCE;
+	last.offset = this->OFFSET;
+	last.upAxis = this->UP;
+	last.forwardAxis = this->FORWARD;
+	last.sceneBounded = this->sceneBounded;
+	last.sceneMin = this->sceneMin;
+	last.sceneMax = this->sceneMax;
+
+	this->stateRecorded = true;
+	this->shadowValid = false;
+	this->version++;
+}
+
+void SgTShadowBox::invalidate() {
+	this->stateRecorded = false;
 }
 
 void SgTShadowBox::update(const float aspect) {
+	//nothing has moved, the bounds and the shadow map are still valid
+	if (this->reuseBounds(aspect)) {
+		return;
+	}
+
+	//get all the vertices, nothing is allocated
+	this->calcCameraFrustum(this->Camera, aspect, this->frustumCorner);
+	SgTShadowBox::calcFrustumPlane(this->frustumCorner, this->frustumPlane);
+	this->fitLightSpace();
+	this->recordState(aspect);
+}
+
+void SgTShadowBox::calcCameraFrustum(SgTCamera* const camera, const float aspect, SgTFrustumCorner& corner) {
 	//update the camera view frustum since our camera FOV and aspect ratio may change every frame
-	this->calcViewFrustumPlanes(aspect);
+	this->calcViewFrustumPlanes(camera, aspect);
 
-	const SgTmat4 rotation = this->getCameraRotation();
+	const SgTmat4 rotation = SgTmat4(SgTmat3(camera->getViewMat()));
 	//rotate the forward and up vector to make it align with the camera
 	const SgTvec3 forward = SgTvec3(rotation * this->FORWARD);
 	const SgTvec3 up = SgTvec3(rotation * this->UP);
@@ -76,46 +230,95 @@ void SgTShadowBox::update(const float aspect) {
 	const SgTvec3 toNear = forward * this->NEAR_PLANE;
 	const SgTvec3 toFar = forward * this->SHADOW_DISTANCE;
 	//center plane for the camera view
-	const SgTvec3 centerNear = toNear + this->Camera->getPosition();
-	const SgTvec3 centerFar = toFar + this->Camera->getPosition();
-	//get all the vertices
-	const SgTvec4* const points = this->calcFrustumVertices(rotation, forward, up, centerNear, centerFar);
-	//we are going to find the maximum and minimum value in both X,Y and Z direction
-	bool first = true;
-	for (int i = 0; i < 8; i++) {
-		if (first) {
-			this->maxX = (points + i)->x;
-			this->minX = (points + i)->x;
-			this->maxY = (points + i)->y;
-			this->minY = (points + i)->y;
-			this->maxZ = (points + i)->z;
-			this->minZ = (points + i)->z;
-			first = false;
-			continue;
-		}
-		if ((points + i)->x > this->maxX) {
-			this->maxX = (points + i)->x;
+	const SgTvec3 centerNear = toNear + camera->getPosition();
+	const SgTvec3 centerFar = toFar + camera->getPosition();
+	this->calcFrustumVertices(forward, up, centerNear, centerFar, corner);
+}
+
+const size_t SgTShadowBox::cullCaster(const SgTvec3* const min, const SgTvec3* const max, const size_t count, unsigned int* const index) const {
+	return this->cullExtrusion(this->frustumPlane, 1u, min, max, count, index);
+}
+
+const size_t SgTShadowBox::cullExtrusion(const SgTvec4* const plane, const unsigned int viewCount, const SgTvec3* const min, const SgTvec3* const max,
+	const size_t count, unsigned int* const index) const {
+	//rows of the light rotation, for transforming the extent of the bounding box to light space
+	SgTvec3 absRow[3];
+	for (int r = 0; r < 3; r++) {
+		absRow[r] = glm::abs(SgTvec3(this->lightView[0][r], this->lightView[1][r], this->lightView[2][r]));
+	}
+
+	size_t casterCount = 0;
+	for (size_t i = 0; i < count; i++) {
+		const SgTvec3 center = (min[i] + max[i]) * 0.5f;
+		const SgTvec3 extent = (max[i] - min[i]) * 0.5f;
+
+		//the extrusion misses a frustum if the box is outside a plane and moves away from it along the light
+		bool caster = false;
+		for (unsigned int v = 0u; v < viewCount && !caster; v++) {
+			caster = true;
+			for (int p = 0; p < 6; p++) {
+				const SgTvec4& pl = plane[v * 6u + p];
+				const SgTvec3 normal = SgTvec3(pl);
+				const float distance = glm::dot(normal, center) + pl.w + glm::dot(glm::abs(normal), extent);
+				if (distance < 0.0f && glm::dot(normal, this->LightDirection) <= 0.0f) {
+					caster = false;
+					break;
+				}
+			}
 		}
-		else if ((points + i)->x < this->minX) {
-			this->minX = (points + i)->x;
+		if (!caster) {
+			continue;
 		}
 
-		if ((points + i)->y > this->maxY) {
-			this->maxY = (points + i)->y;
-		}
-		else if ((points + i)->y < this->minY) {
-			this->minY = (points + i)->y;
+		//the box must also overlap the shadow box across the light, and not be entirely behind it
+		const SgTvec4 lightCenter = this->lightView * SgTvec4(center, 1.0f);
+		const SgTvec3 lightExtent = SgTvec3(glm::dot(absRow[0], extent), glm::dot(absRow[1], extent), glm::dot(absRow[2], extent));
+		if (lightCenter.x + lightExtent.x < this->minX || lightCenter.x - lightExtent.x > this->maxX
+			|| lightCenter.y + lightExtent.y < this->minY || lightCenter.y - lightExtent.y > this->maxY
+			|| lightCenter.z + lightExtent.z < this->minZ) {
+			continue;
 		}
+		index[casterCount++] = static_cast<unsigned int>(i);
+	}
+	return casterCount;
+}
 
-		if ((points + i)->z > this->maxZ) {
-			this->maxZ = (points + i)->z;
+const bool SgTShadowBox::hasSameFrustum(const SgTShadowBox& box) const {
+	return this->Camera == box.Camera && this->NEAR_PLANE == box.NEAR_PLANE && this->SHADOW_DISTANCE == box.SHADOW_DISTANCE
+		&& this->OFFSET == box.OFFSET && this->UP == box.UP && this->FORWARD == box.FORWARD;
+}
+
+void SgTShadowBox::copyBounds(const SgTShadowBox& box, const float aspect) {
+	//the view frustum is in world space, so it does not depend on the light, only the fitting does
+	this->nearWidth = box.nearWidth;
+	this->nearHeight = box.nearHeight;
+	this->farWidth = box.farWidth;
+	this->farHeight = box.farHeight;
+	this->frustumCorner = box.frustumCorner;
+	for (int p = 0; p < 6; p++) {
+		this->frustumPlane[p] = box.frustumPlane[p];
+	}
+	this->fitLightSpace();
+	this->recordState(aspect);
+}
+
+void SgTShadowBox::updateBatch(SgTShadowBox* const* const box, const float* const aspect, const size_t count) {
+	const SgTShadowBox* previous = nullptr;
+	float previousAspect = 0.0f;
+	for (size_t i = 0; i < count; i++) {
+		SgTShadowBox& current = *box[i];
+		//a box whose bounds are reused still has the view frustum of the current camera, so it can be shared as well
+		if (current.reuseBounds(aspect[i])) {
+			previous = &current;
+			previousAspect = aspect[i];
+			continue;
 		}
-		else if ((points + i)->z < this->minZ) {
-			this->minZ = (points + i)->z;
+		if (previous != nullptr && previousAspect == aspect[i] && current.hasSameFrustum(*previous) && previous->hasSameFrustum(current)) {
+			current.copyBounds(*previous, aspect[i]);
+			continue;
 		}
+		current.update(aspect[i]);
+		previous = &current;
+		previousAspect = aspect[i];
 	}
-	this->maxZ += this->OFFSET;
-
-	//clear up
-	delete[] points;
 }
\ No newline at end of file
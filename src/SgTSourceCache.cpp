@@ -0,0 +1,39 @@
+#include "SgTSourceCache.h"
+
+using namespace SglToolkit;
+
+SgTSourceCache::SgTSourceCache() {
+
+}
+
+SgTSourceCache::~SgTSourceCache() {
+
+}
+
+const SgTSourceCache::SgTSourceView SgTSourceCache::getSource(const SgTstring& path) {
+	std::error_code err;
+	const std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, err);
+	if (err) {
+		throw "FileNotFoundException";
+	}
+
+	auto it = this->entry.find(path);
+	if (it == this->entry.end()) {
+		it = this->entry.emplace(path, SgTCacheEntry{ SgTFileMapping(path), modified }).first;
+	}
+	else if (it->second.modifiedTime != modified) {
+		//file has been changed since it was mapped
+		it->second.mapping = SgTFileMapping(path);
+		it->second.modifiedTime = modified;
+	}
+
+	return SgTSourceView{ it->second.mapping.getData(), it->second.mapping.getLength() };
+}
+
+void SgTSourceCache::release(const SgTstring& path) {
+	this->entry.erase(path);
+}
+
+void SgTSourceCache::clear() {
+	this->entry.clear();
+}
\ No newline at end of file
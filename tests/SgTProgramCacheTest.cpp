@@ -0,0 +1,105 @@
+#include "SgTTestContext.h"
+#include "SgTShaderProc.h"
+
+#include <iostream>
+#include <filesystem>
+#include <memory>
+#include <cstring>
+
+using namespace SglToolkit;
+
+/*
+Link the same program with a program cache four times: the first link misses and stores the binary,
+the second link loads it, the third link finds the binary truncated and rejects it, and the fourth link loads the binary stored again.
+
+Usage: SgTProgramCacheTest [cache directory]
+*/
+
+namespace {
+	const char* const VERTEX = "#version 430 core\n"
+		"layout(location = 0) in vec3 position;\n"
+		"void main() { gl_Position = vec4(position, 1.0); }\n";
+	const char* const FRAGMENT = "#version 430 core\n"
+		"layout(location = 0) out vec4 colour;\n"
+		"void main() { colour = vec4(1.0, 0.5, 0.25, 1.0); }\n";
+
+	unsigned int failure = 0u;
+
+	void check(const bool passed, const char* const what) {
+		if (!passed) {
+			std::cerr << "SgTProgramCacheTest: " << what << " failed" << std::endl;
+			failure++;
+		}
+	}
+
+	//Link the test program through the cache and check the cache statistics afterwards
+	void link(SgTProgramCache& cache, const SgTProgramCache::SgTCacheStat expected, const char* const what) {
+		SgTShaderProc proc;
+		proc.useProgramCache(&cache);
+		const GLint vertexLength = static_cast<GLint>(std::strlen(VERTEX)), fragmentLength = static_cast<GLint>(std::strlen(FRAGMENT));
+		proc.addShaderSource(GL_VERTEX_SHADER, &VERTEX, &vertexLength, 1);
+		proc.addShaderSource(GL_FRAGMENT_SHADER, &FRAGMENT, &fragmentLength, 1);
+		GLchar log[512];
+		const SgTShaderStatus status = proc.linkShader(log, sizeof(log));
+		if (status != SgTShaderProc::OK) {
+			std::cerr << log << std::endl;
+		}
+		check(status == SgTShaderProc::OK, what);
+		proc.deleteShader();
+
+		const SgTProgramCache::SgTCacheStat stat = cache.getStat();
+		check(stat.hit == expected.hit && stat.miss == expected.miss && stat.reject == expected.reject, what);
+	}
+
+	//Find the only binary in the cache directory
+	const std::filesystem::path findBinary(const std::filesystem::path& directory) {
+		std::error_code err;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, err)) {
+			if (entry.path().extension() == ".sgtbin") {
+				return entry.path();
+			}
+		}
+		return std::filesystem::path();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const std::filesystem::path directory = argc > 1 ? std::filesystem::path(argv[1]) : std::filesystem::temp_directory_path() / "SgTProgramCacheTest";
+	std::error_code err;
+	std::filesystem::remove_all(directory, err);
+
+	std::unique_ptr<SgTTestContext> context;
+	try {
+		context.reset(new SgTTestContext());
+	}
+	catch (const char* const err) {
+		std::cout << "SgTProgramCacheTest: " << err << ", skipped" << std::endl;
+		return SgTTestContext::SKIP;
+	}
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	if (formatCount == 0) {
+		std::cout << "SgTProgramCacheTest: the driver has no program binary format, skipped" << std::endl;
+		return SgTTestContext::SKIP;
+	}
+
+	SgTProgramCache cache(directory.string());
+	link(cache, { 0u, 1u, 0u }, "first link is a miss");
+	const std::filesystem::path binary = findBinary(directory);
+	check(!binary.empty(), "binary is stored");
+	link(cache, { 1u, 1u, 0u }, "second link is a hit");
+	if (!binary.empty()) {
+		//a truncated binary no longer matches the length in its header
+		std::filesystem::resize_file(binary, std::filesystem::file_size(binary) - 1u);
+		link(cache, { 1u, 1u, 1u }, "truncated binary is rejected");
+		check(std::filesystem::exists(binary), "binary is stored again");
+		link(cache, { 2u, 1u, 1u }, "link after the reject is a hit");
+	}
+	std::filesystem::remove_all(directory, err);
+
+	if (failure != 0u) {
+		return 1;
+	}
+	std::cout << "SgTProgramCacheTest: passed" << std::endl;
+	return 0;
+}
\ No newline at end of file
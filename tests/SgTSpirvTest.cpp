@@ -0,0 +1,89 @@
+#include "SgTTestContext.h"
+#include "SgTShaderProc.h"
+
+#include <iostream>
+#include <memory>
+
+using namespace SglToolkit;
+
+/*
+Load a SPIR-V compute shader that writes its specialization constants into a buffer, specialize it, link it and run it.
+One constant is set twice and the constants are set out of ID order, the last value must be the one that reaches the driver.
+
+Usage: SgTSpirvTest <SgTSpirvTest.comp.spv>
+*/
+
+namespace {
+	unsigned int failure = 0u;
+
+	void check(const bool passed, const char* const what) {
+		if (!passed) {
+			std::cerr << "SgTSpirvTest: " << what << " failed" << std::endl;
+			failure++;
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: SgTSpirvTest <SgTSpirvTest.comp.spv>" << std::endl;
+		return 1;
+	}
+
+	std::unique_ptr<SgTTestContext> context;
+	try {
+		context.reset(new SgTTestContext());
+	}
+	catch (const char* const err) {
+		std::cout << "SgTSpirvTest: " << err << ", skipped" << std::endl;
+		return SgTTestContext::SKIP;
+	}
+	if (!SgTShaderProc::hasSPIRV()) {
+		std::cout << "SgTSpirvTest: the driver does not support SPIR-V, skipped" << std::endl;
+		return SgTTestContext::SKIP;
+	}
+
+	SgTShaderProc::SgTSpecialization specialization;
+	specialization.setConstant(1u, 2.5f);
+	specialization.setConstant(0u, 7u);
+	specialization.setConstant(0u, 42u);
+	check(specialization.index.size() == 2u && specialization.index[0] == 0u && specialization.index[1] == 1u, "constants are sorted without duplicate");
+
+	SgTShaderProc proc;
+	proc.addShaderBinary(GL_COMPUTE_SHADER, argv[1], specialization);
+	GLchar log[512];
+	const SgTShaderStatus status = proc.linkShader(log, sizeof(log));
+	if (status != SgTShaderProc::OK) {
+		std::cerr << log << std::endl;
+	}
+	check(status == SgTShaderProc::OK, "specialized module is linked");
+
+	if (status == SgTShaderProc::OK) {
+		struct {
+			GLuint value;
+			GLfloat scale;
+		} result = { 0u, 0.0f };
+		GLuint buffer;
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(result), &result, GL_DYNAMIC_READ);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+
+		glUseProgram(proc.getP());
+		glDispatchCompute(1, 1, 1);
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(result), &result);
+		check(result.value == 42u, "integer constant is specialized");
+		check(result.scale == 2.5f, "floating point constant is specialized");
+
+		glUseProgram(0);
+		glDeleteBuffers(1, &buffer);
+	}
+	proc.deleteShader();
+
+	if (failure != 0u) {
+		return 1;
+	}
+	std::cout << "SgTSpirvTest: passed" << std::endl;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "SgTTestContext.h"
+
+#include <EGL/eglext.h>
+
+using namespace SglToolkit;
+
+SgTTestContext::SgTTestContext() {
+	//prefer the surfaceless platform, which works without any display server
+	const PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (getPlatformDisplay != NULL) {
+		this->display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if (this->display == EGL_NO_DISPLAY) {
+		this->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	EGLint major, minor;
+	if (this->display == EGL_NO_DISPLAY || !eglInitialize(this->display, &major, &minor)) {
+		throw "NoDisplayException";
+	}
+	if (!eglBindAPI(EGL_OPENGL_API)) {
+		this->destroy();
+		throw "NoContextException";
+	}
+
+	const EGLint configAttribute[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+	EGLConfig config = NULL;
+	EGLint configCount = 0;
+	eglChooseConfig(this->display, configAttribute, &config, 1, &configCount);
+	const EGLint contextAttribute[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE
+	};
+	//a context without config is allowed with EGL_KHR_no_config_context, which is all a surfaceless context needs
+	this->context = eglCreateContext(this->display, configCount > 0 ? config : NULL, EGL_NO_CONTEXT, contextAttribute);
+	if (this->context == EGL_NO_CONTEXT || !eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, this->context)) {
+		this->destroy();
+		throw "NoContextException";
+	}
+	if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+		this->destroy();
+		throw "GladLoadException";
+	}
+}
+
+SgTTestContext::~SgTTestContext() {
+	this->destroy();
+}
+
+void SgTTestContext::destroy() {
+	if (this->context != EGL_NO_CONTEXT) {
+		eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(this->display, this->context);
+		this->context = EGL_NO_CONTEXT;
+	}
+	eglTerminate(this->display);
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef _SgTTestContext_H_
+#define _SgTTestContext_H_
+
+#include "SgTDefineFile.h"
+
+#include <EGL/egl.h>
+
+/**
+ * @brief Simple OpenGL Toolkit
+*/
+namespace SglToolkit {
+
+	/**
+	 * @brief A headless OpenGL core context for tests, made current on the calling thread.
+	 * It is created on a surfaceless display with EGL, so no window or display server is needed.
+	*/
+	class SgTTestContext {
+	private:
+
+		EGLDisplay display = EGL_NO_DISPLAY;
+		EGLContext context = EGL_NO_CONTEXT;
+
+		/**
+		 * @brief Release the context if it has been created, and the display
+		*/
+		void destroy();
+
+	public:
+
+		//The return code of a test that cannot run on this machine, given to CTest as SKIP_RETURN_CODE
+		static constexpr int SKIP = 77;
+
+		/**
+		 * @brief Create the context and load OpenGL functions with glad.
+		 * Throw exception if no OpenGL 4.3 core context can be created
+		*/
+		SgTTestContext();
+
+		SgTTestContext(const SgTTestContext&) = delete;
+
+		SgTTestContext& operator=(const SgTTestContext&) = delete;
+
+		~SgTTestContext();
+
+	};
+}
+#endif//_SgTTestContext_H_
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "SgTCamera/SgTSpectatorCamera.h"
+#include "SgTCamera/SgTCameraPool.h"
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+
+using namespace SglToolkit;
+
+/*
+Compare the time to update many cameras one by one with SgTSpectatorCamera and all together with SgTCameraPool.
+Every frame each camera turns with the mouse, moves forward and right, then the view matrix is calculated.
+
+Usage: SgTCameraBench [camera count] [frame count]
+*/
+
+namespace {
+	typedef std::chrono::steady_clock SgTClock;
+
+	//The cursor position of a camera in a frame, so the cameras do not all turn the same way
+	float cursor(const size_t camera, const unsigned int frame) {
+		return static_cast<float>(frame) * (1.0f + static_cast<float>(camera % 7u) * 0.25f);
+	}
+
+	const double elapsed(const SgTClock::time_point& start) {
+		return std::chrono::duration<double, std::milli>(SgTClock::now() - start).count();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000u;
+	const unsigned int frame = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 100u;
+	if (count == 0u || frame == 0u) {
+		std::cerr << "Usage: SgTCameraBench [camera count] [frame count]" << std::endl;
+		return 1;
+	}
+	const float deltaTime = 1.0f / 60.0f;
+	//sum of the view matrices, so the work cannot be optimised away
+	float checksum[2] = { 0.0f, 0.0f };
+
+	//one camera at a time
+	std::vector<std::unique_ptr<SgTSpectatorCamera>> camera;
+	camera.reserve(count);
+	for (size_t i = 0u; i < count; i++) {
+		camera.emplace_back(new SgTSpectatorCamera(static_cast<float>(i % 360u), 0.0f));
+	}
+	SgTClock::time_point start = SgTClock::now();
+	for (unsigned int f = 0u; f < frame; f++) {
+		for (size_t i = 0u; i < count; i++) {
+			SgTSpectatorCamera& current = *camera[i];
+			const float position = cursor(i, f);
+			current.mouseUpdate(position, position * 0.5f, true);
+			current.keyUpdate(SgTSpectatorCamera::FORWARD, deltaTime);
+			current.keyUpdate(SgTSpectatorCamera::RIGHT, deltaTime);
+			checksum[0] += current.getViewMat()[3][0];
+		}
+	}
+	const double single = elapsed(start);
+
+	//all cameras together
+	SgTCameraPool pool(count);
+	for (size_t i = 0u; i < count; i++) {
+		pool.add(static_cast<float>(i % 360u), 0.0f, SgTvec3(0.0f));
+	}
+	std::vector<float> Xoffset(count), Yoffset(count);
+	const std::vector<unsigned int> mask(count,
+		SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::FORWARD) | SgTSpectatorCamera::getMovementBit(SgTSpectatorCamera::RIGHT));
+	std::vector<SgTmat4> view(count);
+	start = SgTClock::now();
+	for (unsigned int f = 0u; f < frame; f++) {
+		for (size_t i = 0u; i < count; i++) {
+			//the spectator camera skips the offset of the first cursor position
+			const float offset = f == 0u ? 0.0f : cursor(i, f) - cursor(i, f - 1u);
+			Xoffset[i] = offset;
+			Yoffset[i] = -offset * 0.5f;
+		}
+		pool.rotate(Xoffset.data(), Yoffset.data(), true);
+		pool.update();
+		pool.move(mask.data(), deltaTime);
+		pool.getViewMat(view.data());
+		for (size_t i = 0u; i < count; i++) {
+			checksum[1] += view[i][3][0];
+		}
+	}
+	const double together = elapsed(start);
+
+	std::cout << "SgTCameraBench: " << count << " camera(s), " << frame << " frame(s)" << std::endl;
+	std::cout << "SgTSpectatorCamera: " << single / frame << " ms per frame" << std::endl;
+	std::cout << "SgTCameraPool: " << together / frame << " ms per frame, " << single / together << "x" << std::endl;
+	std::cout << "checksum: " << checksum[0] << " " << checksum[1] << std::endl;
+	return 0;
+}
\ No newline at end of file
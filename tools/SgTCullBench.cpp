@@ -0,0 +1,91 @@
+#include "SgTFrustumCuller.h"
+#include "SgTCamera/SgTSpectatorCamera.h"
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+
+using namespace SglToolkit;
+
+/*
+Measure the time to cull bounding spheres and boxes scattered around a camera, with and without the plane cache,
+on the calling thread only and with as many threads as the hardware has.
+The plane cache is filled by one untimed frame first, as if the objects had been culled in the frame before.
+
+Usage: SgTCullBench [object count] [repeat count]
+*/
+
+namespace {
+	typedef std::chrono::steady_clock SgTClock;
+
+	//Cull all objects a number of times, and return the time of one cull in millisecond
+	template<typename Cull>
+	const double measure(const unsigned int repeat, const Cull& cull, size_t& visible) {
+		//warm up and fill the cache
+		visible = cull();
+		const SgTClock::time_point start = SgTClock::now();
+		for (unsigned int r = 0u; r < repeat; r++) {
+			visible = cull();
+		}
+		return std::chrono::duration<double, std::milli>(SgTClock::now() - start).count() / repeat;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000u;
+	const unsigned int repeat = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 20u;
+	if (count == 0u || repeat == 0u) {
+		std::cerr << "Usage: SgTCullBench [object count] [repeat count]" << std::endl;
+		return 1;
+	}
+
+	SgTSpectatorCamera camera(30.0f, 10.0f);
+	camera.setProjection(16.0f / 9.0f, 0.1f, 100.0f);
+	SgTFrustumCuller culler;
+	culler.setFrustum(camera);
+
+	//objects in a cube around the camera, so most of them are outside the frustum like in an open world
+	std::mt19937 random(2023u);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f), size(0.1f, 3.0f);
+	std::vector<float> x(count), y(count), z(count), radius(count), minX(count), minY(count), minZ(count), maxX(count), maxY(count), maxZ(count);
+	for (size_t i = 0u; i < count; i++) {
+		x[i] = position(random);
+		y[i] = position(random);
+		z[i] = position(random);
+		radius[i] = size(random);
+		minX[i] = x[i] - size(random);
+		minY[i] = y[i] - size(random);
+		minZ[i] = z[i] - size(random);
+		maxX[i] = x[i] + size(random);
+		maxY[i] = y[i] + size(random);
+		maxZ[i] = z[i] + size(random);
+	}
+	const SgTFrustumCuller::SgTSphereArray sphere = { x.data(), y.data(), z.data(), radius.data() };
+	const SgTFrustumCuller::SgTBoxArray box = { minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data() };
+	std::vector<unsigned int> index(count);
+	std::vector<unsigned char> sphereCache(count, SgTFrustumCuller::NO_PLANE), boxCache(count, SgTFrustumCuller::NO_PLANE);
+
+	std::cout << "SgTCullBench: " << count << " object(s), " << repeat << " repeat(s)" << std::endl;
+	std::vector<unsigned int> threadCount = { 1u };
+	if (std::thread::hardware_concurrency() > 1u) {
+		threadCount.push_back(std::thread::hardware_concurrency());
+	}
+	for (const unsigned int thread : threadCount) {
+		culler.THREAD_COUNT = thread;
+		for (const bool useCache : { false, true }) {
+			unsigned char* const sCache = useCache ? sphereCache.data() : nullptr;
+			unsigned char* const bCache = useCache ? boxCache.data() : nullptr;
+			size_t sphereVisible, boxVisible;
+			const double sphereTime = measure(repeat, [&]() { return culler.cullSphere(sphere, count, index.data(), sCache); }, sphereVisible);
+			const double boxTime = measure(repeat, [&]() { return culler.cullBox(box, count, index.data(), bCache); }, boxVisible);
+
+			std::cout << thread << " thread(s), " << (useCache ? "plane cache" : "no cache") << ": "
+				<< "spheres " << sphereTime << " ms (" << sphereVisible << " visible), "
+				<< "boxes " << boxTime << " ms (" << boxVisible << " visible)" << std::endl;
+		}
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "SgTShaderProc.h"
+#include "SgTSourceCache.h"
+#include "SgTShaderBundle.h"
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <filesystem>
+#include <cstring>
+#include <cstdlib>
+
+using namespace SglToolkit;
+
+/*
+Measure the time to load shader sources in the different ways the toolkit supports:
+SgTShaderProc::readCode() which copies the file through a file stream, and SgTSourceCache which maps the file,
+either into a new cache every time or into a cache that has mapped the file before,
+and SgTShaderBundle with all shaders packed into one file, either opened every time or opened before.
+Every character loaded is read once, so mapped pages are actually faulted in.
+The bundle is written to the temporary directory and removed afterwards.
+
+Usage: SgTLoadBench [-n <repeat>] <shader>...
+*/
+
+namespace {
+	typedef std::chrono::steady_clock SgTClock;
+
+	void printUsage() {
+		std::cerr << "Usage: SgTLoadBench [-n <repeat>] <shader>..." << std::endl;
+	}
+
+	//Read every character of a source, so the work cannot be optimised away
+	const unsigned int touch(const char* const data, const size_t length) {
+		unsigned int sum = 0u;
+		for (size_t c = 0u; c < length; c++) {
+			sum += static_cast<unsigned char>(data[c]);
+		}
+		return sum;
+	}
+
+	//Load all shaders a number of times, and return the time to load all shaders once in millisecond
+	template<typename Load>
+	const double measure(const unsigned int repeat, const Load& load, unsigned int& checksum) {
+		checksum = 0u;
+		const SgTClock::time_point start = SgTClock::now();
+		for (unsigned int r = 0u; r < repeat; r++) {
+			checksum += load();
+		}
+		return std::chrono::duration<double, std::milli>(SgTClock::now() - start).count() / repeat;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	unsigned int repeat = 100u;
+	std::vector<SgTstring> shader;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			repeat = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (argv[i][0] == '-') {
+			printUsage();
+			return 1;
+		}
+		else {
+			shader.push_back(argv[i]);
+		}
+	}
+	if (shader.empty() || repeat == 0u) {
+		printUsage();
+		return 1;
+	}
+
+	unsigned int checksum[5];
+	double time[5];
+	std::error_code ignored;
+	const SgTstring bundlePath = (std::filesystem::temp_directory_path() / "SgTLoadBench.sgtb").string();
+	try {
+		time[0] = measure(repeat, [&shader]() {
+			unsigned int sum = 0u;
+			for (const SgTstring& path : shader) {
+				const SgTstring code = SgTShaderProc::readCode(path);
+				sum += touch(code.data(), code.length());
+			}
+			return sum;
+		}, checksum[0]);
+
+		time[1] = measure(repeat, [&shader]() {
+			SgTSourceCache cache;
+			unsigned int sum = 0u;
+			for (const SgTstring& path : shader) {
+				const SgTSourceCache::SgTSourceView view = cache.getSource(path);
+				sum += touch(view.data, view.length);
+			}
+			return sum;
+		}, checksum[1]);
+
+		SgTSourceCache cache;
+		time[2] = measure(repeat, [&shader, &cache]() {
+			unsigned int sum = 0u;
+			for (const SgTstring& path : shader) {
+				const SgTSourceCache::SgTSourceView view = cache.getSource(path);
+				sum += touch(view.data, view.length);
+			}
+			return sum;
+		}, checksum[2]);
+
+		//the shaders are named by their path as given
+		std::vector<std::pair<SgTstring, SgTstring>> content;
+		for (const SgTstring& path : shader) {
+			content.emplace_back(path, SgTShaderProc::readCode(path));
+		}
+		SgTShaderBundle::write(bundlePath, content);
+
+		time[3] = measure(repeat, [&shader, &bundlePath]() {
+			const SgTShaderBundle bundle(bundlePath);
+			unsigned int sum = 0u;
+			for (const SgTstring& path : shader) {
+				const SgTShaderBundle::SgTBundleShader source = bundle.getShader(path);
+				sum += touch(source.data, source.length);
+			}
+			return sum;
+		}, checksum[3]);
+
+		const SgTShaderBundle bundle(bundlePath);
+		time[4] = measure(repeat, [&shader, &bundle]() {
+			unsigned int sum = 0u;
+			for (const SgTstring& path : shader) {
+				const SgTShaderBundle::SgTBundleShader source = bundle.getShader(path);
+				sum += touch(source.data, source.length);
+			}
+			return sum;
+		}, checksum[4]);
+	}
+	catch (const char* const err) {
+		std::filesystem::remove(bundlePath, ignored);
+		std::cerr << "SgTLoadBench: " << err << std::endl;
+		return 1;
+	}
+	catch (const std::exception& err) {
+		std::filesystem::remove(bundlePath, ignored);
+		std::cerr << "SgTLoadBench: " << err.what() << std::endl;
+		return 1;
+	}
+	std::filesystem::remove(bundlePath, ignored);
+
+	std::cout << "SgTLoadBench: " << shader.size() << " shader(s), " << repeat << " repeat(s)" << std::endl;
+	std::cout << "readCode: " << time[0] << " ms" << std::endl;
+	std::cout << "SgTSourceCache, new cache: " << time[1] << " ms" << std::endl;
+	std::cout << "SgTSourceCache, mapped before: " << time[2] << " ms" << std::endl;
+	std::cout << "SgTShaderBundle, new bundle: " << time[3] << " ms" << std::endl;
+	std::cout << "SgTShaderBundle, opened before: " << time[4] << " ms" << std::endl;
+	for (int i = 1; i < 5; i++) {
+		if (checksum[i] != checksum[0]) {
+			std::cerr << "SgTLoadBench: the sources loaded are different" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
\ No newline at end of file
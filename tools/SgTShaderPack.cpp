@@ -0,0 +1,112 @@
+#include "SgTShaderBundle.h"
+#include "SgTShaderPreprocessor.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <cstring>
+
+using namespace SglToolkit;
+
+/*
+Pack shaders into a bundle that can be read by SgTShaderBundle.
+Every shader is preprocessed, so the bundle does not depend on any included file at runtime.
+Shaders are named by their path relative to the root directory, with '/' as separator.
+
+Usage: SgTShaderPack -o <bundle> [-r <root>] [-I <include dir>]... [-d <depfile>] <shader>...
+*/
+
+namespace {
+	void printUsage() {
+		std::cerr << "Usage: SgTShaderPack -o <bundle> [-r <root>] [-I <include dir>]... [-d <depfile>] <shader>..." << std::endl;
+	}
+
+	//Escape a path for a Makefile style dependency file
+	SgTstring escapeDepPath(const SgTstring& path) {
+		SgTstring escaped;
+		for (const char c : path) {
+			if (c == ' ' || c == '#') {
+				escaped += '\\';
+			}
+			else if (c == '$') {
+				escaped += '$';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	SgTstring output, root = ".", depfile;
+	std::vector<SgTstring> shader;
+	SgTShaderPreprocessor preprocessor;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "-o") == 0 && hasValue) {
+			output = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-r") == 0 && hasValue) {
+			root = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-I") == 0 && hasValue) {
+			preprocessor.addIncludePath(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "-d") == 0 && hasValue) {
+			depfile = argv[++i];
+		}
+		else if (argv[i][0] == '-') {
+			printUsage();
+			return 1;
+		}
+		else {
+			shader.push_back(argv[i]);
+		}
+	}
+	if (output.empty() || shader.empty()) {
+		printUsage();
+		return 1;
+	}
+
+	std::vector<std::pair<SgTstring, SgTstring>> content;
+	std::vector<SgTstring> dependency;
+	try {
+		for (const SgTstring& path : shader) {
+			const SgTstring name = std::filesystem::path(path).lexically_relative(root).generic_string();
+			if (name.empty() || name.compare(0, 2, "..") == 0) {
+				std::cerr << "SgTShaderPack: " << path << " is not under " << root << std::endl;
+				return 1;
+			}
+			content.emplace_back(name, preprocessor.preprocess(path));
+
+			dependency.push_back(SgTShaderPreprocessor::normalisePath(path));
+			for (const SgTstring& included : preprocessor.getDependency(path)) {
+				dependency.push_back(included);
+			}
+		}
+		SgTShaderBundle::write(output, content);
+	}
+	catch (const char* const err) {
+		std::cerr << "SgTShaderPack: " << err << std::endl;
+		return 1;
+	}
+
+	//let the build system know which headers the bundle depends on
+	if (!depfile.empty()) {
+		std::ofstream dep(depfile, std::ios_base::out | std::ios_base::trunc);
+		dep << escapeDepPath(output) << ":";
+		for (const SgTstring& path : dependency) {
+			dep << " \\\n  " << escapeDepPath(path);
+		}
+		dep << "\n";
+		if (dep.fail()) {
+			std::cerr << "SgTShaderPack: cannot write " << depfile << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "SgTShaderPack: " << content.size() << " shader(s) packed into " << output << std::endl;
+	return 0;
+}
\ No newline at end of file